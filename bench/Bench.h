@@ -0,0 +1,44 @@
+/**
+ *
+ *
+ * @file Bench.h
+ * @brief Minimal timing helpers shared by the benchmarks.
+ * @date 10/17/26
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace bench {
+
+// Wall time in nanoseconds that f takes to run.
+template<typename F>
+double nanoseconds(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Best of several runs of f, in nanoseconds, to filter out scheduling noise.
+template<typename F>
+double bestOf(int runs, F&& f) {
+    double best = nanoseconds(f);
+    for (int i = 1; i < runs; ++i) {
+        double time = nanoseconds(f);
+        if (time < best)
+            best = time;
+    }
+    return best;
+}
+
+// Stores a result where the compiler cannot see it being unused, so that the work producing it is kept.
+inline volatile std::size_t sink = 0;
+
+template<typename T>
+void consume(const T& value) {
+    sink = sink + static_cast<std::size_t>(value);
+}
+
+}
@@ -0,0 +1,110 @@
+/**
+ *
+ *
+ * @file ConcurrentMultiKeyMap.cpp
+ * @brief Lookup throughput of a sharded ConcurrentMultiKeyMap against one map behind a single mutex.
+ * @date 10/17/26
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "Bench.h"
+#include "crampl/ConcurrentMultiKeyMap.h"
+
+namespace {
+
+using Map = crampl::MultiKeyMap<std::unordered_map, int, int, int>;
+
+constexpr int firstKeys = 1 << 12;
+constexpr int secondKeys = 16;
+constexpr std::size_t opsPerThread = 1 << 20;
+
+// The whole map behind one mutex, which is what ConcurrentMultiKeyMap replaces.
+struct LockedMap {
+    std::optional<int> find(int a, int b) const {
+        std::lock_guard lock(mutex);
+        return crampl::find(map, a, b);
+    }
+    void emplace(int a, int b, int value) {
+        std::lock_guard lock(mutex);
+        crampl::emplace(map, std::piecewise_construct, std::forward_as_tuple(a), std::forward_as_tuple(b), std::forward_as_tuple(value));
+    }
+    mutable std::mutex mutex;
+    Map map;
+};
+
+struct ShardedMap {
+    std::optional<int> find(int a, int b) const {
+        return crampl::find(map, a, b);
+    }
+    void emplace(int a, int b, int value) {
+        crampl::emplace(map, std::piecewise_construct, std::forward_as_tuple(a), std::forward_as_tuple(b), std::forward_as_tuple(value));
+    }
+    crampl::ConcurrentMultiKeyMap<Map> map;
+};
+
+// Every thread runs opsPerThread operations on random keys, one in writeEvery of them an emplace.
+// Returns the throughput over all threads in million operations per second.
+template<typename M>
+double throughput(M& map, unsigned threads, std::size_t writeEvery) {
+    double time = bench::bestOf(3, [&] {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&map, t, writeEvery] {
+                std::uint32_t state = 0x9e3779b9u * (t + 1);
+                std::size_t found = 0;
+                for (std::size_t i = 0; i < opsPerThread; ++i) {
+                    state ^= state << 13;
+                    state ^= state >> 17;
+                    state ^= state << 5;
+                    int a = static_cast<int>(state % firstKeys);
+                    int b = static_cast<int>((state >> 16) % secondKeys);
+                    if (writeEvery && i % writeEvery == 0)
+                        map.emplace(a, b, a + b);
+                    else
+                        found += map.find(a, b).has_value();
+                }
+                bench::consume(found);
+            });
+        }
+        for (std::thread& worker : workers)
+            worker.join();
+    });
+    return static_cast<double>(opsPerThread * threads) / time * 1e3;
+}
+
+}
+
+// Usage: crampl_bench_concurrent_multi_key_map [max threads], by default one per hardware thread.
+int main(int argc, char** argv) {
+    LockedMap locked;
+    ShardedMap sharded;
+    for (int a = 0; a < firstKeys; ++a) {
+        for (int b = 0; b < secondKeys; b += 2) {
+            locked.emplace(a, b, a + b);
+            sharded.emplace(a, b, a + b);
+        }
+    }
+
+    unsigned maxThreads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : std::thread::hardware_concurrency();
+    maxThreads = std::max(1u, maxThreads);
+    for (std::size_t writeEvery : {std::size_t(0), std::size_t(100), std::size_t(10)}) {
+        if (writeEvery)
+            std::printf("1 in %zu operations writes\n", writeEvery);
+        else
+            std::printf("read only\n");
+        std::printf("%8s %16s %16s\n", "threads", "mutex [Mop/s]", "sharded [Mop/s]");
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+            std::printf("%8u %16.1f %16.1f\n", threads, throughput(locked, threads, writeEvery), throughput(sharded, threads, writeEvery));
+        std::printf("\n");
+    }
+}
@@ -0,0 +1,118 @@
+/**
+ *
+ *
+ * @file FlatHashMap.cpp
+ * @brief Insertion and lookup time of MultiKeyMaps over FlatHashMap against std::unordered_map, per nesting depth.
+ * @date 10/17/26
+ */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Bench.h"
+#include "crampl/FlatHashMap.h"
+#include "crampl/MultiKeyMap.h"
+
+namespace {
+
+constexpr std::size_t entryCount = 1 << 20;
+
+// Keys of entryCount entries spread evenly over the levels, and as many random lookups of which about
+// half hit. Keys are scattered over a larger range so that the levels are not dense.
+template<std::size_t Depth>
+struct Workload {
+    Workload() {
+        std::mt19937 rng(42);
+        std::size_t perLevel = 1;
+        while (std::size_t(std::pow(double(perLevel + 1), double(Depth))) <= entryCount)
+            ++perLevel;
+        std::uniform_int_distribution<int> scatter(0, 1 << 24);
+        std::vector<int> levelKeys(2 * perLevel);
+        for (int& key : levelKeys)
+            key = scatter(rng);
+        for (std::size_t i = 0; i < entryCount; ++i) {
+            std::array<int, Depth> key;
+            std::size_t rest = i;
+            for (std::size_t level = 0; level < Depth; ++level) {
+                key[level] = levelKeys[rest % perLevel];
+                rest /= perLevel;
+            }
+            inserts.push_back(key);
+        }
+        std::uniform_int_distribution<std::size_t> pick(0, 2 * perLevel - 1);
+        for (std::size_t i = 0; i < entryCount; ++i) {
+            std::array<int, Depth> key = inserts[i];
+            // Replacing the last key by a random one gives a miss about half of the time.
+            if (i % 2)
+                key[Depth - 1] = levelKeys[pick(rng)];
+            lookups.push_back(key);
+        }
+        std::shuffle(inserts.begin(), inserts.end(), rng);
+    }
+
+    std::vector<std::array<int, Depth>> inserts;
+    std::vector<std::array<int, Depth>> lookups;
+};
+
+template<std::size_t>
+using Int = int;
+
+template<template<typename...> typename MapKind, std::size_t... I>
+auto makeMap(std::index_sequence<I...>) {
+    return crampl::MultiKeyMap<MapKind, Int<I>..., int>{};
+}
+
+// Nanoseconds per insertion and per lookup into a MultiKeyMap of Depth levels over MapKind.
+template<template<typename...> typename MapKind, std::size_t Depth>
+std::pair<double, double> measure(const Workload<Depth>& workload) {
+    using Map = decltype(makeMap<MapKind>(std::make_index_sequence<Depth>{}));
+    // Each run fills a fresh map, so that destroying the previous one is not timed.
+    Map map;
+    double insertTime = 0.0;
+    for (int run = 0; run < 3; ++run) {
+        Map fresh;
+        double time = bench::nanoseconds([&] {
+            for (const auto& key : workload.inserts) {
+                std::apply([&](auto... keys) {
+                    crampl::emplace(fresh, std::piecewise_construct, std::forward_as_tuple(keys)..., std::forward_as_tuple((keys + ...)));
+                }, key);
+            }
+        });
+        insertTime = run == 0 ? time : std::min(insertTime, time);
+        map = std::move(fresh);
+    }
+    double lookupTime = bench::bestOf(3, [&] {
+        std::size_t found = 0;
+        for (const auto& key : workload.lookups)
+            found += std::apply([&](auto... keys) { return crampl::find_ptr(std::as_const(map), keys...) != nullptr; }, key);
+        bench::consume(found);
+    });
+    return {insertTime / double(workload.inserts.size()), lookupTime / double(workload.lookups.size())};
+}
+
+template<std::size_t Depth>
+void run() {
+    Workload<Depth> workload;
+    auto [stdInsert, stdLookup] = measure<std::unordered_map, Depth>(workload);
+    auto [flatInsert, flatLookup] = measure<crampl::FlatHashMap, Depth>(workload);
+    std::printf("%6zu %18.1f %18.1f %18.1f %18.1f\n", Depth, stdInsert, flatInsert, stdLookup, flatLookup);
+}
+
+}
+
+int main() {
+    std::printf("%zu entries, half of the lookups miss; times in ns per operation\n", entryCount);
+    std::printf("%6s %18s %18s %18s %18s\n", "depth", "unordered insert", "flat insert", "unordered find", "flat find");
+    run<1>();
+    run<2>();
+    run<3>();
+    run<4>();
+}
@@ -0,0 +1,138 @@
+/**
+ *
+ *
+ * @file Function.cpp
+ * @brief Size, move and call cost of crampl::Function against std::function.
+ * @date 10/17/26
+ */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Bench.h"
+#include "crampl/Function.h"
+
+namespace {
+
+constexpr std::size_t functionCount = 1 << 10;
+
+// Nanoseconds per move of a Function of type F holding a copy of callable. Measures what a vector does
+// when it grows: move constructing each element into new storage and destroying the old one.
+template<typename F, typename Callable>
+double moveCost(const Callable& callable) {
+    std::allocator<F> alloc;
+    F* from = alloc.allocate(functionCount);
+    F* to = alloc.allocate(functionCount);
+    for (std::size_t i = 0; i < functionCount; ++i)
+        std::construct_at(from + i, callable);
+    double time = bench::bestOf(100, [&] {
+        std::uninitialized_move(from, from + functionCount, to);
+        std::destroy(from, from + functionCount);
+        std::swap(from, to);
+    });
+    (*from)();
+    std::destroy(from, from + functionCount);
+    alloc.deallocate(from, functionCount);
+    alloc.deallocate(to, functionCount);
+    return time / double(functionCount);
+}
+
+template<typename Callable>
+void compareMoves(const char* name, const Callable& callable) {
+    std::printf("%-28s %20.2f %20.2f %20.2f\n", name,
+                moveCost<crampl::Function<void(), 3 * sizeof(void*)>>(callable),
+                moveCost<std::function<void()>>(callable),
+                moveCost<Callable>(callable));
+}
+
+constexpr std::size_t callCount = 1 << 20;
+
+// Counts the copies and moves of by-value arguments that a call makes.
+struct Counted {
+    Counted() = default;
+    Counted(const Counted&) { ++copies; }
+    Counted(Counted&&) noexcept { ++moves; }
+    static inline int copies = 0;
+    static inline int moves = 0;
+};
+
+template<typename F, typename Arg>
+void countOne(F& f, Arg&& arg) {
+    Counted::copies = Counted::moves = 0;
+    f(std::forward<Arg>(arg));
+    char counts[32];
+    std::snprintf(counts, sizeof(counts), "%d/%d", Counted::copies, Counted::moves);
+    std::printf(" %12s", counts);
+}
+
+template<typename F>
+void countCopies(const char* name, F f) {
+    Counted counted;
+    std::printf("%-28s", name);
+    countOne(f, counted);
+    countOne(f, std::move(counted));
+    countOne(f, Counted{});
+    std::printf("\n");
+}
+
+// Nanoseconds per call of f with an lvalue argument.
+template<typename F, typename Arg>
+double callCost(F& f, const Arg& arg) {
+    double time = bench::bestOf(10, [&] {
+        for (std::size_t i = 0; i < callCount; ++i)
+            f(arg);
+    });
+    return time / double(callCount);
+}
+
+template<typename Arg, typename Callable>
+void compareCalls(const char* name, const Callable& callable, const Arg& arg) {
+    crampl::Function<std::size_t(Arg)> function = callable;
+    std::function<std::size_t(Arg)> stdFunction = callable;
+    Callable direct = callable;
+    std::printf("%-28s %20.2f %20.2f %20.2f\n", name, callCost(function, arg), callCost(stdFunction, arg), callCost(direct, arg));
+}
+
+}
+
+int main() {
+    std::printf("%-28s %20s %20s\n", "size [bytes]", "crampl::Function", "std::function");
+    std::printf("%-28s %20zu %20zu\n", "default buffer", sizeof(crampl::Function<void()>), sizeof(std::function<void()>));
+    std::printf("%-28s %20zu %20zu\n", "buffer of 3 pointers", sizeof(crampl::Function<void(), 3 * sizeof(void*)>), sizeof(std::function<void()>));
+    std::printf("\n");
+
+    std::printf("%-28s %20s %20s %20s\n", "move [ns]", "crampl::Function", "std::function", "callable itself");
+    int counter = 0;
+    compareMoves("pointer capture", [&counter] { ++counter; });
+    compareMoves("trivial 24 byte capture", [&counter, a = std::size_t(1), b = std::size_t(2)] { counter += int(a + b); });
+    std::string text = "not trivially relocatable";
+    compareMoves("std::string capture", [&counter, text] { counter += int(text.size()); });
+    auto shared = std::make_shared<int>(1);
+    compareMoves("std::shared_ptr capture", [&counter, shared] { counter += *shared; });
+    std::printf("\n");
+
+    std::printf("%-28s %20s %20s %20s\n", "call [ns]", "crampl::Function", "std::function", "callable itself");
+    std::size_t sum = 0;
+    compareCalls<int>("int", [&sum](int i) { return sum += std::size_t(i); }, 1);
+    compareCalls<std::array<std::uint64_t, 32>>("256 byte array by value", [&sum](std::array<std::uint64_t, 32> a) {
+        return sum += a[sum % a.size()];
+    }, std::array<std::uint64_t, 32>{});
+    compareCalls<std::string>("std::string by value", [&sum](std::string s) { return sum += s.size(); }, text);
+    compareCalls<const std::string&>("std::string by reference", [&sum](const std::string& s) { return sum += s.size(); }, text);
+    std::printf("\n");
+
+    std::printf("%-28s %12s %12s %12s\n", "copies/moves of a parameter", "lvalue", "xvalue", "temporary");
+    auto byValue = [](Counted) {};
+    countCopies("crampl::Function", crampl::Function<void(Counted)>(byValue));
+    countCopies("std::function", std::function<void(Counted)>(byValue));
+    countCopies("callable itself", byValue);
+
+    bench::consume(counter);
+    bench::consume(sum);
+}
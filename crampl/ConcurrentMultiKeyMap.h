@@ -0,0 +1,160 @@
+/**
+ *
+ *
+ * @file ConcurrentMultiKeyMap.h
+ * @brief MultiKeyMap that is sharded on its first key for concurrent access.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+#include <utility>
+
+#include "MultiKeyMap.h"
+
+namespace crampl {
+
+namespace detail {
+
+// Type of the first key of a MultiKeyMap, also for flat levels.
+template<typename Key>
+struct FirstKey {
+    using type = Key;
+};
+
+template<typename Key, typename... Keys>
+struct FirstKey<CompositeKey<Key, Keys...>> {
+    using type = Key;
+};
+
+template<typename Map>
+using FirstKey_t = typename FirstKey<typename Map::key_type>::type;
+
+}
+
+// Thread-safe wrapper around a MultiKeyMap (nested, flat or pmr). Entries are distributed over
+// ShardCount independent maps by the hash of their first key, and each shard is guarded by its own
+// reader/writer lock, so lookups only contend with writers to the same shard.
+// Since no references into the shards can be handed out safely, find and emplace return copies;
+// visit gives access to a stored value in place while the shard is locked.
+template<typename Map, std::size_t ShardCount = 64, typename Hash = std::hash<detail::FirstKey_t<Map>>>
+class ConcurrentMultiKeyMap {
+    static_assert(ShardCount > 0 && (ShardCount & (ShardCount - 1)) == 0, "ShardCount must be a power of two.");
+
+    // Aligned to keep the locks of neighbouring shards on separate cache lines.
+    struct alignas(64) Shard {
+        template<typename... Args>
+        explicit Shard(const Args&... args): map(args...) {}
+        mutable std::shared_mutex mutex;
+        Map map;
+    };
+
+public:
+    using map_type = Map;
+
+    // Constructs every shard's map from args, e.g. a std::pmr::memory_resource*.
+    template<typename... Args>
+    explicit ConcurrentMultiKeyMap(const Args&... args)
+        : shards([&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::array<Shard, ShardCount>{(static_cast<void>(I), Shard(args...))...};
+        }(std::make_index_sequence<ShardCount>{})) {}
+
+    ConcurrentMultiKeyMap(const ConcurrentMultiKeyMap&) = delete;
+    ConcurrentMultiKeyMap& operator=(const ConcurrentMultiKeyMap&) = delete;
+
+    template<typename Key, typename... Keys>
+    auto find(const Key& key, const Keys&... keys) const {
+        const Shard& shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+        return crampl::find(shard.map, key, keys...);
+    }
+
+    // Calls f with a const reference to the value (or inner map) stored under the given keys while
+    // holding the shard's read lock. Returns whether the keys were found.
+    template<typename F, typename Key, typename... Keys>
+    bool visit(F&& f, const Key& key, const Keys&... keys) const {
+        const Shard& shard = shardFor(key);
+        std::shared_lock lock(shard.mutex);
+        if (const auto* value = crampl::find_ptr(shard.map, key, keys...)) {
+            std::invoke(std::forward<F>(f), *value);
+            return true;
+        }
+        return false;
+    }
+
+    template<typename KeyArgs, typename... Args>
+    auto emplace(std::piecewise_construct_t, KeyArgs&& keyArgs, Args&&... args) {
+        // Build the first key once; it is needed for hashing before the map is locked.
+        auto key = std::make_from_tuple<detail::FirstKey_t<Map>>(std::forward<KeyArgs>(keyArgs));
+        Shard& shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        auto value = crampl::emplace(shard.map, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward<Args>(args)...);
+        return value;
+    }
+
+    template<typename Key, typename... Keys>
+    bool erase(const Key& key, const Keys&... keys) {
+        Shard& shard = shardFor(key);
+        std::unique_lock lock(shard.mutex);
+        return crampl::erase(shard.map, key, keys...);
+    }
+
+    std::size_t size() const {
+        std::size_t result = 0;
+        for (const Shard& shard : shards) {
+            std::shared_lock lock(shard.mutex);
+            result += shard.map.size();
+        }
+        return result;
+    }
+
+private:
+    template<typename Key>
+    Shard& shardFor(const Key& key) {
+        return shards[shardIndex(key)];
+    }
+    template<typename Key>
+    const Shard& shardFor(const Key& key) const {
+        return shards[shardIndex(key)];
+    }
+    template<typename Key>
+    static std::size_t shardIndex(const Key& key) {
+        // Fibonacci hashing, so that weak hashes like the identity on integers spread over all shards.
+        std::uint64_t hash = Hash{}(key) * 0x9e3779b97f4a7c15ull;
+        if constexpr (ShardCount == 1) {
+            return 0;
+        } else {
+            return static_cast<std::size_t>(hash >> (64 - std::countr_zero(ShardCount)));
+        }
+    }
+
+    std::array<Shard, ShardCount> shards;
+};
+
+template<typename Map, std::size_t ShardCount, typename Hash, typename... B>
+auto find(const ConcurrentMultiKeyMap<Map, ShardCount, Hash>& map, B&&... keys) {
+    return map.find(keys...);
+}
+
+template<typename Map, std::size_t ShardCount, typename Hash, typename... B>
+auto find(ConcurrentMultiKeyMap<Map, ShardCount, Hash>& map, B&&... keys) {
+    return map.find(keys...);
+}
+
+template<typename Map, std::size_t ShardCount, typename Hash, typename... B>
+auto emplace(ConcurrentMultiKeyMap<Map, ShardCount, Hash>& map, std::piecewise_construct_t, B&&... keys) {
+    return map.emplace(std::piecewise_construct, std::forward<B>(keys)...);
+}
+
+template<typename Map, std::size_t ShardCount, typename Hash, typename... B>
+bool erase(ConcurrentMultiKeyMap<Map, ShardCount, Hash>& map, B&&... keys) {
+    return map.erase(keys...);
+}
+
+}
@@ -0,0 +1,654 @@
+/**
+ *
+ *
+ * @file FlatHashMap.h
+ * @brief Open-addressing hash map with SIMD group probing, usable as MapKind of a MultiKeyMap.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace crampl {
+
+namespace detail {
+
+// Control bytes of FlatHashMap slots. Full slots hold the 7 high bits of their hash (h2), all other
+// states have the sign bit set. The control bytes end in a sentinel that stops iteration.
+enum : std::int8_t {
+    ctrlEmpty = -128,
+    ctrlDeleted = -2,
+    ctrlSentinel = -1
+};
+
+// A group of control bytes that is matched against h2 in parallel. Match results are bit masks
+// with one bit per slot of the group.
+struct ControlGroup {
+    static constexpr std::size_t width = 16;
+
+#if defined(__SSE2__)
+    explicit ControlGroup(const std::int8_t* ctrl)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+    std::uint32_t match(std::int8_t h2) const {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2))));
+    }
+    std::uint32_t matchEmpty() const {
+        return match(ctrlEmpty);
+    }
+    std::uint32_t matchEmptyOrDeleted() const {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl));
+    }
+
+    __m128i ctrl;
+#else
+    explicit ControlGroup(const std::int8_t* ctrl) {
+        std::copy_n(ctrl, width, this->ctrl);
+    }
+
+    std::uint32_t match(std::int8_t h2) const {
+        std::uint32_t result = 0;
+        for (std::size_t i = 0; i < width; ++i)
+            result |= std::uint32_t(ctrl[i] == h2) << i;
+        return result;
+    }
+    std::uint32_t matchEmpty() const {
+        return match(ctrlEmpty);
+    }
+    std::uint32_t matchEmptyOrDeleted() const {
+        std::uint32_t result = 0;
+        for (std::size_t i = 0; i < width; ++i)
+            result |= std::uint32_t(ctrl[i] < 0) << i;
+        return result;
+    }
+
+    std::int8_t ctrl[width];
+#endif
+};
+
+}
+
+// Swiss-table style hash map: slots are stored in one contiguous array next to an array of one-byte
+// control words, and lookups compare the control words of a whole group of slots in one SIMD step.
+// The interface follows std::unordered_map closely enough to serve as MapKind of a MultiKeyMap, including
+// piecewise emplace, transparent lookup and allocators (polymorphic allocators propagate to inner maps).
+// Unlike std::unordered_map, any insertion may move the stored entries, which invalidates references
+// and iterators; key and value types should be nothrow move constructible.
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+         typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class FlatHashMap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<const Key, Value>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+private:
+    union Slot {
+        Slot() {}
+        ~Slot() {}
+        value_type value;
+    };
+
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using SlotAllocator = typename AllocTraits::template rebind_alloc<Slot>;
+    using CtrlAllocator = typename AllocTraits::template rebind_alloc<std::int8_t>;
+    using Group = detail::ControlGroup;
+
+    static constexpr bool transparent = requires {
+        typename Hash::is_transparent;
+        typename KeyEqual::is_transparent;
+    };
+    static constexpr size_type npos = size_type(-1);
+
+    template<bool Const>
+    class Iterator {
+        friend class FlatHashMap;
+        friend class Iterator<true>;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+        Iterator() = default;
+        template<bool OtherConst> requires (Const && !OtherConst)
+        Iterator(const Iterator<OtherConst>& other): ctrl(other.ctrl), slot(other.slot) {}
+
+        reference operator*() const { return slot->value; }
+        pointer operator->() const { return std::addressof(slot->value); }
+
+        Iterator& operator++() {
+            ++ctrl;
+            ++slot;
+            skipEmpty();
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+            return lhs.ctrl == rhs.ctrl;
+        }
+
+    private:
+        Iterator(const std::int8_t* ctrl, Slot* slot): ctrl(ctrl), slot(slot) {}
+
+        void skipEmpty() {
+            while (*ctrl < detail::ctrlSentinel) {
+                ++ctrl;
+                ++slot;
+            }
+        }
+
+        const std::int8_t* ctrl = nullptr;
+        Slot* slot = nullptr;
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashMap() = default;
+    explicit FlatHashMap(size_type bucketCount, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(),
+                         const Allocator& alloc = Allocator())
+        : hash(hash), equal(equal), alloc(alloc) {
+        reserve(bucketCount);
+    }
+    explicit FlatHashMap(const Allocator& alloc): alloc(alloc) {}
+    template<std::input_iterator It>
+    FlatHashMap(It first, It last, size_type bucketCount = 0, const Hash& hash = Hash(),
+                const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+        : FlatHashMap(bucketCount, hash, equal, alloc) {
+        insert(first, last);
+    }
+    FlatHashMap(std::initializer_list<value_type> values, size_type bucketCount = 0, const Hash& hash = Hash(),
+                const KeyEqual& equal = KeyEqual(), const Allocator& alloc = Allocator())
+        : FlatHashMap(values.begin(), values.end(), bucketCount, hash, equal, alloc) {}
+
+    FlatHashMap(const FlatHashMap& other)
+        : FlatHashMap(other, AllocTraits::select_on_container_copy_construction(other.alloc)) {}
+    FlatHashMap(const FlatHashMap& other, const Allocator& alloc)
+        : hash(other.hash), equal(other.equal), alloc(alloc) {
+        reserve(other.size());
+        insert(other.begin(), other.end());
+    }
+    FlatHashMap(FlatHashMap&& other) noexcept
+        : hash(std::move(other.hash)), equal(std::move(other.equal)), alloc(std::move(other.alloc)) {
+        steal(other);
+    }
+    FlatHashMap(FlatHashMap&& other, const Allocator& alloc)
+        : hash(std::move(other.hash)), equal(std::move(other.equal)), alloc(alloc) {
+        if (this->alloc == other.alloc) {
+            steal(other);
+        } else {
+            moveElementsFrom(other);
+        }
+    }
+
+    ~FlatHashMap() {
+        release();
+    }
+
+    FlatHashMap& operator=(const FlatHashMap& other) {
+        if (this == &other)
+            return *this;
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+            if (alloc != other.alloc) {
+                release();
+                reset();
+            }
+            alloc = other.alloc;
+        }
+        hash = other.hash;
+        equal = other.equal;
+        clear();
+        reserve(other.size());
+        insert(other.begin(), other.end());
+        return *this;
+    }
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept(AllocTraits::is_always_equal::value ||
+                                                         AllocTraits::propagate_on_container_move_assignment::value) {
+        if (this == &other)
+            return *this;
+        hash = std::move(other.hash);
+        equal = std::move(other.equal);
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            release();
+            alloc = std::move(other.alloc);
+            steal(other);
+        } else if (alloc == other.alloc) {
+            release();
+            steal(other);
+        } else {
+            clear();
+            moveElementsFrom(other);
+        }
+        return *this;
+    }
+    FlatHashMap& operator=(std::initializer_list<value_type> values) {
+        clear();
+        insert(values);
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept { return alloc; }
+    hasher hash_function() const { return hash; }
+    key_equal key_eq() const { return equal; }
+
+    iterator begin() noexcept {
+        iterator it = iteratorAt(0);
+        it.skipEmpty();
+        return it;
+    }
+    const_iterator begin() const noexcept {
+        const_iterator it = iteratorAt(0);
+        it.skipEmpty();
+        return it;
+    }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iteratorAt(capacity); }
+    const_iterator end() const noexcept { return iteratorAt(capacity); }
+    const_iterator cend() const noexcept { return end(); }
+
+    bool empty() const noexcept { return count_ == 0; }
+    size_type size() const noexcept { return count_; }
+    size_type max_size() const noexcept { return std::allocator_traits<SlotAllocator>::max_size(SlotAllocator(alloc)); }
+
+    size_type bucket_count() const noexcept { return capacity; }
+    float load_factor() const noexcept { return capacity ? float(count_) / float(capacity) : 0.0f; }
+    float max_load_factor() const noexcept { return 7.0f / 8.0f; }
+    // Bytes allocated for control bytes and slots, as reported by MultiKeyMap stats.
+    std::size_t heap_bytes() const noexcept {
+        return capacity ? (capacity + 1) * sizeof(std::int8_t) + capacity * sizeof(Slot) : 0;
+    }
+
+    void reserve(size_type count) {
+        size_type newCapacity = Group::width;
+        while (maxLoad(newCapacity) < count)
+            newCapacity *= 2;
+        if (newCapacity > capacity)
+            resize(newCapacity);
+    }
+    void rehash(size_type count) {
+        reserve(std::max(count_, size_type(count * max_load_factor())));
+    }
+
+    void clear() noexcept {
+        destroyElements();
+        if (capacity) {
+            std::fill_n(ctrl, capacity, detail::ctrlEmpty);
+            growthLeft = maxLoad(capacity);
+        }
+        count_ = 0;
+    }
+
+    template<typename K>
+    requires (transparent || std::is_same_v<K, Key>)
+    iterator find(const K& key) {
+        size_type index = findIndex(key);
+        return index == npos ? end() : iteratorAt(index);
+    }
+    template<typename K>
+    requires (transparent || std::is_same_v<K, Key>)
+    const_iterator find(const K& key) const {
+        size_type index = findIndex(key);
+        return index == npos ? end() : iteratorAt(index);
+    }
+    iterator find(const Key& key) { return find<Key>(key); }
+    const_iterator find(const Key& key) const { return find<Key>(key); }
+
+    template<typename K>
+    requires (transparent || std::is_same_v<K, Key>)
+    bool contains(const K& key) const { return findIndex(key) != npos; }
+    bool contains(const Key& key) const { return findIndex(key) != npos; }
+    template<typename K>
+    requires (transparent || std::is_same_v<K, Key>)
+    size_type count(const K& key) const { return contains(key); }
+
+    // Prefetches the first group a lookup of key probes, e.g. ahead of a batch of lookups.
+    template<typename K>
+    requires (transparent || std::is_same_v<K, Key>)
+    void prefetch(const K& key) const {
+        if (count_ == 0)
+            return;
+        size_type offset = splitHash(hash(key)).first * Group::width;
+        prefetchLine(ctrl + offset);
+        prefetchLine(slots + offset);
+    }
+    void prefetch(const Key& key) const { prefetch<Key>(key); }
+    size_type count(const Key& key) const { return contains(key); }
+
+    Value& at(const Key& key) {
+        size_type index = findIndex(key);
+        if (index == npos)
+            throw std::out_of_range("crampl::FlatHashMap::at");
+        return slots[index].value.second;
+    }
+    const Value& at(const Key& key) const {
+        return const_cast<FlatHashMap&>(*this).at(key);
+    }
+    Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+    Value& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
+
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        return emplaceKeyed(std::forward<K>(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template<typename KeyArgs, typename ValueArgs>
+    std::pair<iterator, bool> emplace(std::piecewise_construct_t, KeyArgs&& keyArgs, ValueArgs&& valueArgs) {
+        return std::apply([&](auto&&... args) {
+            if constexpr (sizeof...(args) == 1) {
+                return emplaceKeyed(static_cast<decltype(args)>(args)..., std::forward<ValueArgs>(valueArgs));
+            } else {
+                return emplaceKeyed(std::make_obj_using_allocator<Key>(alloc, static_cast<decltype(args)>(args)...),
+                                    std::forward<ValueArgs>(valueArgs));
+            }
+        }, std::forward<KeyArgs>(keyArgs));
+    }
+    template<typename K, typename V>
+    std::pair<iterator, bool> emplace(K&& key, V&& value) {
+        return emplaceKeyed(std::forward<K>(key), std::forward_as_tuple(std::forward<V>(value)));
+    }
+    template<typename P>
+    std::pair<iterator, bool> emplace(P&& value) {
+        return emplace(std::get<0>(std::forward<P>(value)), std::get<1>(std::forward<P>(value)));
+    }
+    template<typename... Args>
+    iterator emplace_hint(const_iterator, Args&&... args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) { return emplace(value); }
+    std::pair<iterator, bool> insert(value_type&& value) { return emplace(std::move(value)); }
+    template<std::input_iterator It>
+    void insert(It first, It last) {
+        for (; first != last; ++first)
+            emplace(*first);
+    }
+    void insert(std::initializer_list<value_type> values) { insert(values.begin(), values.end()); }
+
+    iterator erase(const_iterator pos) {
+        size_type index = static_cast<size_type>(pos.slot - slots);
+        eraseAt(index);
+        iterator next = iteratorAt(index);
+        next.skipEmpty();
+        return next;
+    }
+    iterator erase(iterator pos) {
+        return erase(const_iterator(pos));
+    }
+    template<typename K>
+    requires (transparent || std::is_same_v<K, Key>)
+    size_type erase(const K& key) {
+        size_type index = findIndex(key);
+        if (index == npos)
+            return 0;
+        eraseAt(index);
+        return 1;
+    }
+    size_type erase(const Key& key) { return erase<Key>(key); }
+
+    void swap(FlatHashMap& other) noexcept {
+        using std::swap;
+        swap(hash, other.hash);
+        swap(equal, other.equal);
+        if constexpr (AllocTraits::propagate_on_container_swap::value)
+            swap(alloc, other.alloc);
+        swap(ctrl, other.ctrl);
+        swap(slots, other.slots);
+        swap(capacity, other.capacity);
+        swap(count_, other.count_);
+        swap(growthLeft, other.growthLeft);
+    }
+    friend void swap(FlatHashMap& lhs, FlatHashMap& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    friend bool operator==(const FlatHashMap& lhs, const FlatHashMap& rhs) {
+        if (lhs.size() != rhs.size())
+            return false;
+        for (const auto& [key, value] : lhs) {
+            auto it = rhs.find(key);
+            if (it == rhs.end() || !(it->second == value))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    // Maximum number of full and deleted slots before the table is rehashed.
+    static constexpr size_type maxLoad(size_type capacity) {
+        return capacity - capacity / 8;
+    }
+
+    static void prefetchLine(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#endif
+    }
+
+    static const std::int8_t* emptyControl() {
+        static constexpr std::int8_t sentinel = detail::ctrlSentinel;
+        return &sentinel;
+    }
+
+    iterator iteratorAt(size_type index) const {
+        return capacity ? iterator(ctrl + index, slots + index) : iterator(emptyControl(), nullptr);
+    }
+
+    // Splits a hash into the index of the first group to probe and the 7-bit tag stored in the control bytes.
+    // The hash is scrambled first, since std::hash is the identity for integers.
+    std::pair<size_type, std::int8_t> splitHash(std::size_t h) const {
+        std::uint64_t mixed = std::uint64_t(h) * 0x9e3779b97f4a7c15ull;
+        size_type groups = capacity / Group::width;
+        size_type group = static_cast<size_type>(mixed >> (57 - std::countr_zero(groups))) & (groups - 1);
+        return {group, static_cast<std::int8_t>(mixed >> 57)};
+    }
+
+    // Visits the groups in triangular order, which reaches every group of a power-of-two table,
+    // until f returns a result for one of them.
+    template<typename F>
+    size_type probe(std::size_t h, F&& f) const {
+        auto [group, h2] = splitHash(h);
+        size_type groupMask = capacity / Group::width - 1;
+        for (size_type step = 1; ; ++step) {
+            if (std::optional<size_type> index = f(group * Group::width, Group(ctrl + group * Group::width), h2))
+                return *index;
+            group = (group + step) & groupMask;
+        }
+    }
+
+    template<typename K>
+    size_type findIndex(const K& key) const {
+        if (count_ == 0)
+            return npos;
+        return findIndex(key, hash(key));
+    }
+
+    // Lookup with a precomputed hash, which the insertion path reuses to place a missing key.
+    template<typename K>
+    size_type findIndex(const K& key, std::size_t h) const {
+        if (count_ == 0)
+            return npos;
+        return probe(h, [&](size_type offset, const Group& group, std::int8_t h2) -> std::optional<size_type> {
+            for (std::uint32_t m = group.match(h2); m; m &= m - 1) {
+                size_type candidate = offset + std::countr_zero(m);
+                if (equal(slots[candidate].value.first, key))
+                    return candidate;
+            }
+            if (group.matchEmpty())
+                return npos;
+            return std::nullopt;
+        });
+    }
+
+    size_type findInsertIndex(std::size_t h) const {
+        return probe(h, [](size_type offset, const Group& group, std::int8_t) -> std::optional<size_type> {
+            if (std::uint32_t m = group.matchEmptyOrDeleted())
+                return offset + std::countr_zero(m);
+            return std::nullopt;
+        });
+    }
+
+    template<typename K, typename ValueArgs>
+    std::pair<iterator, bool> emplaceKeyed(K&& key, ValueArgs&& valueArgs) {
+        if constexpr (!transparent && !std::is_same_v<std::remove_cvref_t<K>, Key>) {
+            // The temporary key allocates like the stored one, so that it can be moved into the slot.
+            return emplaceKeyed(std::make_obj_using_allocator<Key>(alloc, std::forward<K>(key)), std::forward<ValueArgs>(valueArgs));
+        } else {
+            std::size_t h = hash(key);
+            if (size_type index = findIndex(key, h); index != npos)
+                return {iteratorAt(index), false};
+            if (capacity == 0)
+                resize(Group::width);
+            size_type index = findInsertIndex(h);
+            if (growthLeft == 0 && ctrl[index] != detail::ctrlDeleted) {
+                // Rehash in place if at least half of the used slots are tombstones, grow otherwise.
+                resize(count_ * 2 >= maxLoad(capacity) ? capacity * 2 : capacity);
+                index = findInsertIndex(h);
+            }
+            AllocTraits::construct(alloc, std::addressof(slots[index].value), std::piecewise_construct,
+                                   std::forward_as_tuple(std::forward<K>(key)), std::forward<ValueArgs>(valueArgs));
+            growthLeft -= ctrl[index] == detail::ctrlEmpty;
+            ctrl[index] = splitHash(h).second;
+            ++count_;
+            return {iteratorAt(index), true};
+        }
+    }
+
+    void eraseAt(size_type index) {
+        AllocTraits::destroy(alloc, std::addressof(slots[index].value));
+        // Probing stops at groups with an empty slot, so the slot can only become empty again if its group
+        // already has an empty slot; otherwise it leaves a tombstone.
+        if (Group(ctrl + index / Group::width * Group::width).matchEmpty()) {
+            ctrl[index] = detail::ctrlEmpty;
+            ++growthLeft;
+        } else {
+            ctrl[index] = detail::ctrlDeleted;
+        }
+        --count_;
+    }
+
+    void resize(size_type newCapacity) {
+        std::int8_t* oldCtrl = ctrl;
+        Slot* oldSlots = slots;
+        size_type oldCapacity = capacity;
+
+        CtrlAllocator ctrlAlloc(alloc);
+        SlotAllocator slotAlloc(alloc);
+        ctrl = std::allocator_traits<CtrlAllocator>::allocate(ctrlAlloc, newCapacity + 1);
+        slots = std::allocator_traits<SlotAllocator>::allocate(slotAlloc, newCapacity);
+        std::fill_n(ctrl, newCapacity, detail::ctrlEmpty);
+        ctrl[newCapacity] = detail::ctrlSentinel;
+        capacity = newCapacity;
+        growthLeft = maxLoad(newCapacity) - count_;
+
+        for (size_type i = 0; i < oldCapacity; ++i) {
+            if (oldCtrl[i] < 0)
+                continue;
+            value_type& old = oldSlots[i].value;
+            std::size_t h = hash(old.first);
+            size_type index = findInsertIndex(h);
+            // The old entry is destroyed right after, so its key may be moved from despite being const.
+            AllocTraits::construct(alloc, std::addressof(slots[index].value), std::piecewise_construct,
+                                   std::forward_as_tuple(std::move(const_cast<Key&>(old.first))),
+                                   std::forward_as_tuple(std::move(old.second)));
+            AllocTraits::destroy(alloc, std::addressof(old));
+            ctrl[index] = splitHash(h).second;
+        }
+        if (oldCapacity)
+            deallocate(oldCtrl, oldSlots, oldCapacity);
+    }
+
+    void destroyElements() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (size_type i = 0; i < capacity; ++i)
+                if (ctrl[i] >= 0)
+                    AllocTraits::destroy(alloc, std::addressof(slots[i].value));
+        }
+    }
+
+    void deallocate(std::int8_t* oldCtrl, Slot* oldSlots, size_type oldCapacity) {
+        CtrlAllocator ctrlAlloc(alloc);
+        SlotAllocator slotAlloc(alloc);
+        std::allocator_traits<CtrlAllocator>::deallocate(ctrlAlloc, oldCtrl, oldCapacity + 1);
+        std::allocator_traits<SlotAllocator>::deallocate(slotAlloc, oldSlots, oldCapacity);
+    }
+
+    void release() noexcept {
+        destroyElements();
+        if (capacity)
+            deallocate(ctrl, slots, capacity);
+    }
+
+    void reset() noexcept {
+        ctrl = nullptr;
+        slots = nullptr;
+        capacity = 0;
+        count_ = 0;
+        growthLeft = 0;
+    }
+
+    void steal(FlatHashMap& other) noexcept {
+        ctrl = other.ctrl;
+        slots = other.slots;
+        capacity = other.capacity;
+        count_ = other.count_;
+        growthLeft = other.growthLeft;
+        other.reset();
+    }
+
+    void moveElementsFrom(FlatHashMap& other) {
+        reserve(other.size());
+        for (auto& [key, value] : other)
+            emplace(std::move(const_cast<Key&>(key)), std::move(value));
+        other.clear();
+    }
+
+    std::int8_t* ctrl = nullptr;
+    Slot* slots = nullptr;
+    size_type capacity = 0;
+    size_type count_ = 0;
+    size_type growthLeft = 0;
+    [[no_unique_address]] Hash hash;
+    [[no_unique_address]] KeyEqual equal;
+    [[no_unique_address]] Allocator alloc;
+};
+
+namespace pmr {
+
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using FlatHashMap = crampl::FlatHashMap<Key, Value, Hash, KeyEqual, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>>;
+
+}
+
+}
@@ -1,6 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <exception>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace crampl {
 
@@ -12,22 +20,102 @@ public:
 	}
 };
 
+// Whether objects of type T can be moved by copying their bytes, without running the move constructor on
+// the destination and the destructor on the source. Functions move such callables with a memcpy.
+// Can be specialized for types that are not trivially copyable but still relocatable, e.g. callables
+// holding a std::unique_ptr.
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template<typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
 namespace detail {
 
-template<typename T, bool IsConst>
+// Arguments cross the type-erasure boundary of Function and FunctionRef as references, as copies if they
+// are small and trivially copyable, and otherwise as an ErasedArg. An ErasedArg constructs the by-value
+// parameter from the caller's argument and returns it as a prvalue, which initializes the callee's parameter
+// directly. A call through the boundary thus copies and moves arguments exactly like a direct call.
+template<typename T>
+constexpr bool passedDirectly = std::is_reference_v<T>
+	|| (std::is_trivially_copyable_v<T> && sizeof(T) <= 2 * sizeof(void*));
+
+template<typename T>
+class ErasedArg {
+public:
+	template<typename U>
+	explicit ErasedArg(U&& arg) noexcept
+		: source(std::addressof(arg)), construct([](const void* source) -> T {
+			using Source = std::remove_reference_t<U>;
+			return T(std::forward<U>(*const_cast<Source*>(static_cast<const Source*>(source))));
+		}) {}
+
+	T operator()() const {
+		return construct(source);
+	}
+
+private:
+	const void* source;
+	T (*construct)(const void*);
+};
+
+// Whether arguments of types CallArgs implicitly convert to the parameters of the signature Params, i.e.
+// whether a direct call with them would compile.
+template<typename Params, typename... CallArgs>
+constexpr bool acceptsArgs = false;
+
+template<typename... Args, typename... CallArgs>
+requires (sizeof...(Args) == sizeof...(CallArgs))
+constexpr bool acceptsArgs<void(Args...), CallArgs...> = (std::is_convertible_v<CallArgs&&, Args> && ...);
+
+template<typename T>
+using Erased = std::conditional_t<passedDirectly<T>, T, ErasedArg<T>>;
+
+template<typename T, typename U>
+Erased<T> eraseArg(U&& arg) {
+	if constexpr (passedDirectly<T>) {
+		return std::forward<U>(arg);
+	} else {
+		return ErasedArg<T>(std::forward<U>(arg));
+	}
+}
+
+template<typename T>
+decltype(auto) unerasedArg(Erased<T>& arg) {
+	if constexpr (passedDirectly<T>) {
+		return static_cast<T&&>(arg);
+	} else {
+		return arg();
+	}
+}
+
+template<typename T, bool IsConst, std::size_t InlineBytes, std::size_t InlineAlign, bool AllowHeap>
 class Function;
 
-template<typename R, typename... Args, bool IsConst>
-class Function<R(Args...), IsConst> final {
+template<typename R, typename... Args, bool IsConst, std::size_t InlineBytes, std::size_t InlineAlign, bool AllowHeap>
+class Function<R(Args...), IsConst, InlineBytes, InlineAlign, AllowHeap> final {
 	using VoidPtrWithConstness = std::conditional_t<IsConst, const void*, void*>;
-	typedef Function<R(Args...), IsConst> selfType;
+	typedef Function<R(Args...), IsConst, InlineBytes, InlineAlign, AllowHeap> selfType;
+
+	// The buffer holds either the callable itself or a pointer to it on the heap.
+	static constexpr std::size_t storageSize = std::max(InlineBytes, sizeof(void*));
+	static constexpr std::size_t storageAlign = std::max(InlineAlign, alignof(void*));
 public:
+	// Whether callables of type T are stored in the inline buffer instead of on the heap.
+	template<typename T>
+	static constexpr bool storedInline = sizeof(T) <= storageSize && alignof(T) <= storageAlign;
+
 	Function() = default;
 	Function(const Function &) = delete;
 	template<typename T>
 	Function(T&& lambda) noexcept {
 		init_from(std::forward<T>(lambda));
 	}
+	// Allocates callables that are not stored inline with alloc, which may also be a std::pmr::memory_resource*.
+	template<typename Alloc, typename T>
+	Function(std::allocator_arg_t, const Alloc& alloc, T&& lambda) noexcept {
+		init_from(std::allocator_arg, alloc, std::forward<T>(lambda));
+	}
 	~Function() {
 		destroy();
 	}
@@ -41,77 +129,134 @@ public:
 	}
 
 	template<typename... Args2>
+	requires acceptsArgs<void(Args...), Args2...>
 	R operator()(Args2&&... args) const {
-		return invoke(state, std::forward<Args2>(args)...);
+		return vtable->invoke(const_cast<VoidPtrWithConstness>(static_cast<const void*>(state)), eraseArg<Args>(std::forward<Args2>(args))...);
 	}
 	template<typename... Args2>
+	requires acceptsArgs<void(Args...), Args2...>
 	R operator()(Args2&&... args) {
-		return invoke(state, std::forward<Args2>(args)...);
+		return vtable->invoke(state, eraseArg<Args>(std::forward<Args2>(args))...);
+	}
+
+	// Entry point and argument of the current callable: invoker()(target(), args...) calls it.
+	auto invoker() const noexcept {
+		return vtable->invoke;
+	}
+	VoidPtrWithConstness target() const noexcept {
+		return const_cast<VoidPtrWithConstness>(static_cast<const void*>(state));
 	}
 
 private:
-	VoidPtrWithConstness state;
-	R (*invoke)(VoidPtrWithConstness, Args...) = bad_invoke;
-	void (*manager)(selfType*, selfType*) = noop_manager;
+	// One static table per callable type. Null relocate and destroy entries mean that moving is a memcpy
+	// of the used part of the buffer and destroying is a no-op, which avoids the indirect calls for trivially
+	// relocatable callables and for callables on the heap, whose buffer only holds a pointer.
+	struct VTable {
+		R (*invoke)(VoidPtrWithConstness, Erased<Args>...);
+		void (*relocate)(void* dst, void* src) noexcept;
+		void (*destroy)(void* state) noexcept;
+		std::size_t usedBytes;
+	};
 
-	void destroy() {
-		manager(this, nullptr);
-	}
-	void move_from(selfType* src) {
-		manager(src, this);
+	alignas(storageAlign) unsigned char state[storageSize];
+	const VTable* vtable = &emptyVTable;
+
+	static R bad_invoke(VoidPtrWithConstness, Erased<Args>...) {
+		throw bad_call();
 	}
-	static void noop_manager(selfType*, selfType*) {
+
+	static constexpr VTable emptyVTable {bad_invoke, nullptr, nullptr, 0};
+
+	template<typename T>
+	static constexpr VTable inlineVTable {
+		[](VoidPtrWithConstness state, Erased<Args>... args) -> R {
+			using TPtrWithConstness = std::conditional_t<IsConst, const T*, T*>;
+			return (*std::launder(static_cast<TPtrWithConstness>(state)))(unerasedArg<Args>(args)...);
+		},
+		is_trivially_relocatable_v<T> ? nullptr : +[](void* dst, void* src) noexcept {
+			T* source = std::launder(static_cast<T*>(src));
+			new (dst) T(std::move(*source));
+			source->~T();
+		},
+		std::is_trivially_destructible_v<T> ? nullptr : +[](void* state) noexcept {
+			std::launder(static_cast<T*>(state))->~T();
+		},
+		// Stateless callables leave their byte of storage uninitialized, so there is nothing to copy.
+		std::is_empty_v<T> ? 0 : sizeof(T)
+	};
+
+	// Callable on the heap together with the allocator that frees it again.
+	template<typename T, typename Alloc>
+	struct HeapState {
+		[[no_unique_address]] Alloc alloc;
+		T callable;
+	};
+
+	template<typename T, typename Alloc>
+	using HeapStateAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<HeapState<T, Alloc>>;
+
+	template<typename T, typename Alloc>
+	static HeapState<T, Alloc>* heapState(const void* state) {
+		HeapState<T, Alloc>* ptr;
+		std::memcpy(&ptr, state, sizeof(ptr));
+		return ptr;
 	}
-	static R bad_invoke(VoidPtrWithConstness, Args...) {
-		throw bad_call();
+
+	template<typename T, typename Alloc>
+	static constexpr VTable heapVTable {
+		[](VoidPtrWithConstness state, Erased<Args>... args) -> R {
+			using TRefWithConstness = std::conditional_t<IsConst, const T&, T&>;
+			return static_cast<TRefWithConstness>(heapState<T, Alloc>(state)->callable)(unerasedArg<Args>(args)...);
+		},
+		nullptr,
+		[](void* state) noexcept {
+			HeapState<T, Alloc>* ptr = heapState<T, Alloc>(state);
+			HeapStateAllocator<T, Alloc> alloc(ptr->alloc);
+			std::destroy_at(ptr);
+			std::allocator_traits<HeapStateAllocator<T, Alloc>>::deallocate(alloc, ptr, 1);
+		},
+		sizeof(void*)
+	};
+
+	void destroy() {
+		if (vtable->destroy)
+			vtable->destroy(state);
 	}
 
 	void init_from(Function&& _rhs) {
-		manager = _rhs.manager; _rhs.manager = noop_manager;
-		invoke = _rhs.invoke; _rhs.invoke = bad_invoke;
-		move_from(&_rhs);
+		vtable = std::exchange(_rhs.vtable, &emptyVTable);
+		if (vtable->relocate) {
+			vtable->relocate(state, _rhs.state);
+		} else {
+			std::memcpy(state, _rhs.state, vtable->usedBytes);
+		}
 	}
 
-	template<typename T>
-	void init_from(T&& lambda) {
+	template<typename Lambda>
+	void init_from(Lambda&& lambda) {
+		init_from(std::allocator_arg, std::allocator<std::byte>(), std::forward<Lambda>(lambda));
+	}
+
+	template<typename Lambda>
+	void init_from(std::allocator_arg_t, std::pmr::memory_resource* resource, Lambda&& lambda) {
+		init_from(std::allocator_arg, std::pmr::polymorphic_allocator<std::byte>(resource), std::forward<Lambda>(lambda));
+	}
+
+	template<typename Alloc, typename Lambda>
+	requires (!std::is_convertible_v<const Alloc&, std::pmr::memory_resource*>)
+	void init_from(std::allocator_arg_t, const Alloc& allocator, Lambda&& lambda) {
+		using T = std::decay_t<Lambda>;
 		static_assert(std::is_nothrow_move_constructible_v<T>);
-		using TPtrWithConstness = std::conditional_t<IsConst, const T*, T*>;
-		if constexpr(sizeof(T) <= sizeof(state)) {
-			manager = [](selfType* src, selfType* dst) {
-				if (dst) {
-					// Move
-					new (&dst->state) T(std::move(*reinterpret_cast<T*>(&src->state)));
-				} else {
-					// Destroy
-					reinterpret_cast<T*>(&src->state)->~T();
-				}
-			};
-			invoke = [](VoidPtrWithConstness state, Args... args) -> R {
-				if constexpr(std::is_same_v<R, void>) {
-					(*reinterpret_cast<TPtrWithConstness>(&state))(std::forward<Args>(args)...);
-				} else {
-					return (*reinterpret_cast<TPtrWithConstness>(&state))(std::forward<Args>(args)...);
-				}
-			};
-			new (&state) T(std::forward<T>(lambda));
+		static_assert(AllowHeap || storedInline<T>, "Callable does not fit into the inline buffer of this InplaceFunction.");
+		if constexpr(storedInline<T>) {
+			new (state) T(std::forward<Lambda>(lambda));
+			vtable = &inlineVTable<T>;
 		} else {
-			manager  = [](selfType *src, selfType *dst) {
-				if (dst) {
-					// Move
-					dst->state = src->state;
-				} else {
-					// Destroy
-					delete reinterpret_cast<T*>(src->state);
-				}
-			};
-			invoke = [](VoidPtrWithConstness state, Args... args) -> R {
-				if constexpr(std::is_same_v<R, void>) {
-					(*reinterpret_cast<TPtrWithConstness>(state))(std::forward<Args>(args)...);
-				} else {
-					return (*reinterpret_cast<TPtrWithConstness>(state))(std::forward<Args>(args)...);
-				}
-			};
-			state = new T(std::forward<T>(lambda));
+			HeapStateAllocator<T, Alloc> alloc(allocator);
+			HeapState<T, Alloc>* ptr = std::allocator_traits<HeapStateAllocator<T, Alloc>>::allocate(alloc, 1);
+			new (ptr) HeapState<T, Alloc>{allocator, T(std::forward<Lambda>(lambda))};
+			std::memcpy(state, &ptr, sizeof(ptr));
+			vtable = &heapVTable<T, Alloc>;
 		}
 	}
 };
@@ -119,11 +264,25 @@ private:
 }
 
 template<typename T>
+class FunctionRef;
+
+// Type-erased, move-only callable. Callables of up to InlineBytes bytes with an alignment of up to
+// InlineAlign are stored inline, larger ones on the heap unless AllowHeap is false, in which case
+// storing them does not compile.
+template<typename T, std::size_t InlineBytes = sizeof(void*), std::size_t InlineAlign = alignof(void*), bool AllowHeap = true>
 class Function;
 
-template<typename R, typename... Args>
-class Function<R(Args...)> {
+// Function that never allocates: callables that do not fit into its inline buffer are rejected at compile time.
+template<typename T, std::size_t InlineBytes, std::size_t InlineAlign = alignof(void*)>
+using InplaceFunction = Function<T, InlineBytes, InlineAlign, false>;
+
+template<typename R, typename... Args, std::size_t InlineBytes, std::size_t InlineAlign, bool AllowHeap>
+class Function<R(Args...), InlineBytes, InlineAlign, AllowHeap> {
+	using Impl = detail::Function<R(Args...), false, InlineBytes, InlineAlign, AllowHeap>;
 public:
+	template<typename T>
+	static constexpr bool storedInline = Impl::template storedInline<T>;
+
 	Function(const Function&) = delete;
 	Function(Function&&) = default;
 	template<typename... ConstrArgs>
@@ -136,6 +295,7 @@ public:
 		return *this;
 	}
 	template<typename... CallArgs>
+	requires detail::acceptsArgs<void(Args...), CallArgs...>
 	R operator()(CallArgs&&... args) {
 		if constexpr (std::is_same_v<R, void>) {
 			impl(std::forward<CallArgs>(args)...);
@@ -144,12 +304,17 @@ public:
 		}
 	}
 private:
-	detail::Function<R(Args...), false> impl;
+	template<typename> friend class FunctionRef;
+	Impl impl;
 };
 
-template<typename R, typename... Args>
-class Function<R(Args...) const> {
+template<typename R, typename... Args, std::size_t InlineBytes, std::size_t InlineAlign, bool AllowHeap>
+class Function<R(Args...) const, InlineBytes, InlineAlign, AllowHeap> {
+	using Impl = detail::Function<R(Args...), true, InlineBytes, InlineAlign, AllowHeap>;
 public:
+	template<typename T>
+	static constexpr bool storedInline = Impl::template storedInline<T>;
+
 	Function(const Function&) = delete;
 	Function(Function&&) = default;
 	template<typename... ConstrArgs>
@@ -162,6 +327,7 @@ public:
 		return *this;
 	}
 	template<typename... CallArgs>
+	requires detail::acceptsArgs<void(Args...), CallArgs...>
 	R operator()(CallArgs&&... args) const {
 		if constexpr (std::is_same_v<R, void>) {
 			impl(std::forward<CallArgs>(args)...);
@@ -170,7 +336,82 @@ public:
 		}
 	}
 private:
-	detail::Function<R(Args...), true> impl;
+	template<typename> friend class FunctionRef;
+	Impl impl;
+};
+
+namespace detail {
+
+template<typename T, bool IsConst>
+class FunctionRef;
+
+template<typename R, typename... Args, bool IsConst>
+class FunctionRef<R(Args...), IsConst> {
+	using VoidPtrWithConstness = std::conditional_t<IsConst, const void*, void*>;
+public:
+	template<typename F>
+	requires (!std::is_base_of_v<FunctionRef, std::remove_cvref_t<F>>
+		&& std::is_invocable_r_v<R, std::conditional_t<IsConst, const std::remove_reference_t<F>&, std::remove_reference_t<F>&>, Args...>)
+	FunctionRef(F&& callable) noexcept {
+		using T = std::remove_reference_t<F>;
+		if constexpr (std::is_function_v<T> || std::is_function_v<std::remove_pointer_t<T>>) {
+			// Function pointers are stored in the object pointer, which all supported platforms allow.
+			using FunctionPtr = std::add_pointer_t<std::remove_pointer_t<T>>;
+			object = reinterpret_cast<VoidPtrWithConstness>(static_cast<FunctionPtr>(callable));
+			invoke = [](VoidPtrWithConstness object, Erased<Args>... args) -> R {
+				return static_cast<R>(reinterpret_cast<FunctionPtr>(object)(unerasedArg<Args>(args)...));
+			};
+		} else {
+			// Const callables are only ever invoked as const, also through a FunctionRef to a non-const signature.
+			using TPtrWithConstness = std::conditional_t<IsConst, const T*, T*>;
+			object = const_cast<VoidPtrWithConstness>(static_cast<const void*>(std::addressof(callable)));
+			invoke = [](VoidPtrWithConstness object, Erased<Args>... args) -> R {
+				return static_cast<R>((*static_cast<TPtrWithConstness>(object))(unerasedArg<Args>(args)...));
+			};
+		}
+	}
+
+	// Refers to the callable stored in a Function directly, so that calls take a single indirection.
+	template<typename Impl>
+	FunctionRef(std::in_place_t, const Impl& function) noexcept
+		: object(function.target()), invoke(function.invoker()) {}
+
+	template<typename... Args2>
+	requires acceptsArgs<void(Args...), Args2...>
+	R operator()(Args2&&... args) const {
+		return invoke(object, eraseArg<Args>(std::forward<Args2>(args))...);
+	}
+
+private:
+	VoidPtrWithConstness object;
+	R (*invoke)(VoidPtrWithConstness, Erased<Args>...);
+};
+
+}
+
+// Non-owning reference to a callable, for callbacks that are only invoked while the call that receives
+// them runs. Two pointers in size, never allocates and calls through a single indirection, also when
+// referring to a crampl::Function. The referenced callable must outlive the FunctionRef.
+template<typename R, typename... Args>
+class FunctionRef<R(Args...)> : public detail::FunctionRef<R(Args...), false> {
+	using Base = detail::FunctionRef<R(Args...), false>;
+public:
+	using Base::Base;
+
+	template<std::size_t InlineBytes, std::size_t InlineAlign, bool AllowHeap>
+	FunctionRef(Function<R(Args...), InlineBytes, InlineAlign, AllowHeap>& function) noexcept
+		: Base(std::in_place, function.impl) {}
+};
+
+template<typename R, typename... Args>
+class FunctionRef<R(Args...) const> : public detail::FunctionRef<R(Args...), true> {
+	using Base = detail::FunctionRef<R(Args...), true>;
+public:
+	using Base::Base;
+
+	template<std::size_t InlineBytes, std::size_t InlineAlign, bool AllowHeap>
+	FunctionRef(const Function<R(Args...) const, InlineBytes, InlineAlign, AllowHeap>& function) noexcept
+		: Base(std::in_place, function.impl) {}
 };
 
 }
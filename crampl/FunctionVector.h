@@ -0,0 +1,248 @@
+/**
+ *
+ *
+ * @file FunctionVector.h
+ * @brief Sequence of type-erased callables of one signature, stored back to back in a single buffer.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Function.h"
+
+namespace crampl {
+
+template<typename T>
+class FunctionVector;
+
+// Stores callables of any type like a std::vector<Function<R(Args...)>> would, but in place: each entry is
+// a small header holding its vtable pointer, followed by the callable itself, so no callable lives in its own
+// allocation and calling all of them walks one buffer front to back. Entries are relocated like Functions
+// when the buffer grows. Iterating yields FunctionRefs to the stored callables, which may modify them, so
+// like calling, iterating requires a non-const FunctionVector.
+template<typename R, typename... Args>
+class FunctionVector<R(Args...)> {
+	// Every callable receives the same arguments, so none of them can be moved into a callable.
+	static_assert(!(std::is_rvalue_reference_v<Args> || ...), "FunctionVector parameters cannot be rvalue references.");
+
+	struct VTable {
+		R (*invoke)(void*, detail::Erased<Args>...);
+		void (*relocate)(void* dst, void* src) noexcept;
+		void (*destroy)(void* state) noexcept;
+	};
+
+	struct Header {
+		const VTable* vtable;
+		// Offsets of the callable and of the next header from this header.
+		std::uint32_t object;
+		std::uint32_t next;
+	};
+
+	using Unit = std::max_align_t;
+
+	template<typename T>
+	static constexpr VTable vtableFor {
+		[](void* state, detail::Erased<Args>... args) -> R {
+			return (*std::launder(static_cast<T*>(state)))(detail::unerasedArg<Args>(args)...);
+		},
+		is_trivially_relocatable_v<T> ? nullptr : +[](void* dst, void* src) noexcept {
+			T* source = std::launder(static_cast<T*>(src));
+			new (dst) T(std::move(*source));
+			source->~T();
+		},
+		std::is_trivially_destructible_v<T> ? nullptr : +[](void* state) noexcept {
+			std::launder(static_cast<T*>(state))->~T();
+		}
+	};
+
+	static constexpr std::size_t alignUp(std::size_t offset, std::size_t alignment) {
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+
+public:
+	class iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = FunctionRef<R(Args...)>;
+		using difference_type = std::ptrdiff_t;
+		using reference = value_type;
+		using pointer = void;
+
+		iterator() = default;
+
+		value_type operator*() const {
+			return value_type(std::in_place, Entry{header()});
+		}
+		iterator& operator++() {
+			position += header()->next;
+			return *this;
+		}
+		iterator operator++(int) {
+			auto result = *this;
+			++*this;
+			return result;
+		}
+		friend bool operator==(const iterator& lhs, const iterator& rhs) {
+			return lhs.position == rhs.position;
+		}
+
+	private:
+		friend class FunctionVector;
+
+		// Adapts an entry to the target()/invoker() interface that FunctionRef binds to.
+		struct Entry {
+			Header* header;
+			void* target() const noexcept {
+				return reinterpret_cast<std::byte*>(header) + header->object;
+			}
+			auto invoker() const noexcept {
+				return header->vtable->invoke;
+			}
+		};
+
+		explicit iterator(std::byte* position): position(position) {}
+
+		Header* header() const {
+			return std::launder(reinterpret_cast<Header*>(position));
+		}
+
+		std::byte* position = nullptr;
+	};
+	using size_type = std::size_t;
+
+	FunctionVector() = default;
+	FunctionVector(const FunctionVector&) = delete;
+	FunctionVector& operator=(const FunctionVector&) = delete;
+	FunctionVector(FunctionVector&& other) noexcept
+		: buffer(std::exchange(other.buffer, nullptr)), used(std::exchange(other.used, 0)),
+		  capacity_(std::exchange(other.capacity_, 0)), count(std::exchange(other.count, 0)) {}
+	FunctionVector& operator=(FunctionVector&& other) noexcept {
+		if (this != &other) {
+			clear();
+			deallocate();
+			buffer = std::exchange(other.buffer, nullptr);
+			used = std::exchange(other.used, 0);
+			capacity_ = std::exchange(other.capacity_, 0);
+			count = std::exchange(other.count, 0);
+		}
+		return *this;
+	}
+	~FunctionVector() {
+		clear();
+		deallocate();
+	}
+
+	// Appends a callable, constructed in place from callable.
+	template<typename F>
+	requires std::is_invocable_r_v<R, std::decay_t<F>&, Args...>
+	void push_back(F&& callable) {
+		using T = std::decay_t<F>;
+		static_assert(alignof(T) <= alignof(Unit), "Over-aligned callables are not supported.");
+		static_assert(std::is_nothrow_move_constructible_v<T>);
+		std::size_t object = alignUp(sizeof(Header), alignof(T));
+		std::size_t next = alignUp(object + sizeof(T), alignof(Header));
+		if (used + next > capacity_)
+			grow(used + next);
+		std::byte* position = buffer + used;
+		new (position + object) T(std::forward<F>(callable));
+		new (position) Header{&vtableFor<T>, static_cast<std::uint32_t>(object), static_cast<std::uint32_t>(next)};
+		used += next;
+		++count;
+	}
+
+	// Calls all callables in order with the same arguments, discarding their results. The arguments are
+	// passed on as lvalues, since each of them reaches every callable.
+	template<typename... Args2>
+	requires detail::acceptsArgs<void(Args...), Args2&...>
+	void operator()(Args2&&... args) {
+		for (std::size_t offset = 0; offset < used;) {
+			Header* header = std::launder(reinterpret_cast<Header*>(buffer + offset));
+			header->vtable->invoke(reinterpret_cast<std::byte*>(header) + header->object, detail::eraseArg<Args>(args)...);
+			offset += header->next;
+		}
+	}
+
+	iterator begin() noexcept {
+		return iterator(buffer);
+	}
+	iterator end() noexcept {
+		return iterator(buffer + used);
+	}
+
+	size_type size() const noexcept {
+		return count;
+	}
+	bool empty() const noexcept {
+		return count == 0;
+	}
+	// Bytes of callables and headers stored, and bytes available without growing.
+	size_type size_bytes() const noexcept {
+		return used;
+	}
+	size_type capacity_bytes() const noexcept {
+		return capacity_;
+	}
+
+	void reserve_bytes(size_type bytes) {
+		if (bytes > capacity_)
+			grow(bytes);
+	}
+
+	// Destroys all callables but keeps the buffer.
+	void clear() noexcept {
+		for (std::size_t offset = 0; offset < used;) {
+			Header* header = std::launder(reinterpret_cast<Header*>(buffer + offset));
+			if (header->vtable->destroy)
+				header->vtable->destroy(reinterpret_cast<std::byte*>(header) + header->object);
+			offset += header->next;
+		}
+		used = 0;
+		count = 0;
+	}
+
+private:
+	// Moves all entries to a larger buffer. Offsets are relative to the buffer start, which is always
+	// aligned to Unit, so every entry keeps its layout.
+	void grow(std::size_t required) {
+		std::size_t bytes = std::max({required, 2 * capacity_, std::size_t(256)});
+		std::size_t units = (bytes + sizeof(Unit) - 1) / sizeof(Unit);
+		std::byte* next = reinterpret_cast<std::byte*>(std::allocator<Unit>().allocate(units));
+		for (std::size_t offset = 0; offset < used;) {
+			Header* header = std::launder(reinterpret_cast<Header*>(buffer + offset));
+			Header copy = *header;
+			if (copy.vtable->relocate) {
+				copy.vtable->relocate(next + offset + copy.object, buffer + offset + copy.object);
+			} else {
+				std::memcpy(next + offset + copy.object, buffer + offset + copy.object, copy.next - copy.object);
+			}
+			new (next + offset) Header(copy);
+			offset += copy.next;
+		}
+		deallocate();
+		buffer = next;
+		capacity_ = units * sizeof(Unit);
+	}
+
+	void deallocate() {
+		if (buffer)
+			std::allocator<Unit>().deallocate(reinterpret_cast<Unit*>(buffer), capacity_ / sizeof(Unit));
+		buffer = nullptr;
+		capacity_ = 0;
+	}
+
+	std::byte* buffer = nullptr;
+	std::size_t used = 0;
+	std::size_t capacity_ = 0;
+	std::size_t count = 0;
+};
+
+}
@@ -0,0 +1,122 @@
+/**
+ *
+ *
+ * @file MPMCQueue.h
+ * @brief Bounded lock-free multi-producer multi-consumer queue.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace crampl {
+
+namespace detail {
+
+// Size of a cache line, to keep data written by different threads apart.
+inline constexpr std::size_t cacheLineSize = 64;
+
+}
+
+// Bounded queue of move-only values that any number of threads can push to and pop from without locks.
+// Each slot carries a sequence number that tells producers and consumers whose turn it is, so a push or
+// pop is one CAS on the shared position plus uncontended accesses to the slot. The slots are allocated
+// once by the constructor; pushing and popping never allocate.
+template<typename T>
+class MPMCQueue {
+public:
+	// Capacity is rounded up to a power of two.
+	explicit MPMCQueue(std::size_t capacity)
+		: mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1), cells(std::make_unique<Cell[]>(mask + 1)) {
+		for (std::size_t i = 0; i <= mask; ++i)
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	MPMCQueue(const MPMCQueue&) = delete;
+	MPMCQueue& operator=(const MPMCQueue&) = delete;
+	~MPMCQueue() {
+		while (try_pop()) {}
+	}
+
+	// Constructs a value at the back of the queue, unless the queue is full.
+	template<typename... Args>
+	bool try_emplace(Args&&... args) {
+		std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		Cell* cell;
+		for (;;) {
+			cell = &cells[pos & mask];
+			std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+			if (diff == 0) {
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			} else if (diff < 0) {
+				return false;
+			} else {
+				pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+		new (cell->storage) T(std::forward<Args>(args)...);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool try_push(T&& value) {
+		return try_emplace(std::move(value));
+	}
+
+	// Takes the value at the front of the queue, if any.
+	std::optional<T> try_pop() {
+		std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+		Cell* cell;
+		for (;;) {
+			cell = &cells[pos & mask];
+			std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+			if (diff == 0) {
+				if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			} else if (diff < 0) {
+				return std::nullopt;
+			} else {
+				pos = dequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+		T* value = std::launder(reinterpret_cast<T*>(cell->storage));
+		std::optional<T> result(std::move(*value));
+		value->~T();
+		cell->sequence.store(pos + mask + 1, std::memory_order_release);
+		return result;
+	}
+
+	std::size_t capacity() const noexcept {
+		return mask + 1;
+	}
+
+	// Number of values in the queue; only a snapshot while other threads push or pop.
+	std::size_t size_approx() const noexcept {
+		std::size_t enqueued = enqueuePos.load(std::memory_order_relaxed);
+		std::size_t dequeued = dequeuePos.load(std::memory_order_relaxed);
+		return enqueued > dequeued ? enqueued - dequeued : 0;
+	}
+
+private:
+	struct Cell {
+		std::atomic<std::size_t> sequence;
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+	const std::size_t mask;
+	const std::unique_ptr<Cell[]> cells;
+	alignas(detail::cacheLineSize) std::atomic<std::size_t> enqueuePos {0};
+	alignas(detail::cacheLineSize) std::atomic<std::size_t> dequeuePos {0};
+};
+
+}
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <crampl/NonTypeList.h>
+#include <compare>
 #include <type_traits>
 #include <functional>
 #include <utility>
@@ -141,6 +142,86 @@ using MemberComparatorTemplate = detail::MemberComparator<CompareTemplate, detai
 template<auto... M>
 using MemberComparator = MemberComparatorTemplate<std::less, M...>;
 
+// Three-way comparison of two values using operator<=>. Falls back to a weak ordering derived from
+// operator< for types that only provide the latter.
+template<typename T>
+struct ThreeWayCompare {
+	constexpr auto operator()(const T &lhs, const T &rhs) const
+	{
+		if constexpr (requires { lhs <=> rhs; })
+			return lhs <=> rhs;
+		else
+			return lhs < rhs ? std::weak_ordering::less : rhs < lhs ? std::weak_ordering::greater : std::weak_ordering::equivalent;
+	}
+};
+
+// Three-way comparison of two values as a std::strong_ordering using std::strong_order, which also
+// provides a total order for floating point values.
+template<typename T>
+struct StrongOrderCompare {
+	constexpr std::strong_ordering operator()(const T &lhs, const T &rhs) const
+	{ return std::strong_order(lhs, rhs); }
+};
+
+namespace detail {
+
+// Helper class to compare members in a single pass according to a three-way comparison template.
+// CompareTemplate<T> has to return a comparison category for two values of type T.
+// Unlike MemberComparator, each member is compared once and the comparison stops at the first member that
+// is less or greater, so expensive members such as strings or PointerRanges are not compared twice.
+// Unordered members (e.g. NaN) are skipped like equivalent ones, which matches MemberComparator with std::less.
+template<template<typename...> typename CompareTemplate, typename ObjectType, typename... Args>
+struct ThreeWayMemberComparator;
+
+template<template<typename...> typename CompareTemplate, typename ObjectType, auto m, typename... Args>
+struct ThreeWayMemberComparator<CompareTemplate, ObjectType, MemberWrapper<m>, Args...> {
+	typedef ThreeWayMemberComparator<CompareTemplate, ObjectType, Args...> tailType;
+	typedef std::common_comparison_category_t<
+		decltype(CompareTemplate<typename MemberWrapper<m>::valueType>()(MemberWrapper<m>::get(std::declval<const ObjectType&>()), MemberWrapper<m>::get(std::declval<const ObjectType&>()))),
+		typename tailType::orderingType> orderingType;
+
+	orderingType compare(const ObjectType &lhs, const ObjectType &rhs) const
+	{
+		// Compare m.
+		CompareTemplate<typename MemberWrapper<m>::valueType> cmp;
+		if (auto result = cmp(MemberWrapper<m>::get(lhs), MemberWrapper<m>::get(rhs)); result < 0 || result > 0) return result;
+		// Compare tail.
+		return tailType().compare(lhs, rhs);
+	}
+
+	bool operator()(const ObjectType &lhs, const ObjectType &rhs) const
+	{ return compare(lhs, rhs) < 0; }
+};
+
+// Empty tail case.
+template<template<typename...> typename CompareTemplate, typename ObjectType>
+struct ThreeWayMemberComparator<CompareTemplate, ObjectType> {
+	typedef std::strong_ordering orderingType;
+
+	orderingType compare(const ObjectType &, const ObjectType &) const
+	{ return std::strong_ordering::equal; }
+
+	bool operator()(const ObjectType &, const ObjectType &) const
+	{ return false; }
+};
+
+}
+
+// Templated three-way member comparator.
+// compare(lhs, rhs) compares the members specified by M... once each using the three-way compare template
+// CompareTemplate and returns the common comparison category of the member results; operator() is the
+// corresponding less-than comparison.
+template<template<typename...> typename CompareTemplate, auto... M>
+using ThreeWayMemberComparatorTemplate = detail::ThreeWayMemberComparator<CompareTemplate, detail::ObjectType<M...>, detail::MemberWrapper<M>...>;
+
+// Default three-way member comparison according to operator<=>.
+template<auto... M>
+using ThreeWayMemberComparator = ThreeWayMemberComparatorTemplate<ThreeWayCompare, M...>;
+
+// Three-way member comparison whose compare(lhs, rhs) returns a std::strong_ordering, according to std::strong_order.
+template<auto... M>
+using StrongMemberComparator = ThreeWayMemberComparatorTemplate<StrongOrderCompare, M...>;
+
 namespace detail {
 // Helper for overloaded member comparison.
 template<typename CompareClass, auto... M>
@@ -0,0 +1,222 @@
+/**
+ *
+ *
+ * @file MemberHasher.h
+ * @brief Hash and equality functors for objects keyed on selected members, the unordered counterpart of MemberComparator.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <crampl/MemberComparator.h>
+#include <crampl/PointerRange.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace crampl {
+
+namespace detail {
+
+constexpr std::uint64_t hashSeed = 0x9e3779b97f4a7c15ull;
+constexpr std::uint64_t hashMultiplier = 0xbf58476d1ce4e5b9ull;
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 uint128;
+#endif
+
+// Folded multiply: multiplies to 128 bits and xors the halves, so every input bit affects every output bit.
+inline std::uint64_t hashMix(std::uint64_t a, std::uint64_t b) noexcept
+{
+#ifdef __SIZEOF_INT128__
+	uint128 product = static_cast<uint128>(a) * b;
+	return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+	std::uint64_t h = (a ^ (a >> 31)) * b;
+	return h ^ (h >> 29);
+#endif
+}
+
+inline std::uint64_t hashCombine(std::uint64_t seed, std::uint64_t value) noexcept
+{ return hashMix(seed ^ value, hashMultiplier); }
+
+// Hashes a byte range eight bytes at a time.
+inline std::uint64_t hashBytes(const void *data, std::size_t size, std::uint64_t seed = hashSeed) noexcept
+{
+	const unsigned char *bytes = static_cast<const unsigned char*>(data);
+	std::uint64_t h = seed ^ size;
+	for (; size >= 8; bytes += 8, size -= 8) {
+		std::uint64_t word;
+		std::memcpy(&word, bytes, 8);
+		h = hashCombine(h, word);
+	}
+	if (size > 0) {
+		std::uint64_t word = 0;
+		std::memcpy(&word, bytes, size);
+		h = hashCombine(h, word);
+	}
+	return hashMix(h, hashSeed);
+}
+
+// Values whose bytes are equal exactly if the values compare equal, so that they can be hashed and compared as raw memory.
+template<typename T>
+constexpr bool is_bitwise_comparable = std::is_scalar_v<T> && std::has_unique_object_representations_v<T>;
+
+template<typename T>
+concept BitwiseContiguousRange = std::ranges::contiguous_range<const T> && std::ranges::sized_range<const T>
+	&& is_bitwise_comparable<std::ranges::range_value_t<const T>>;
+
+template<typename T>
+concept TupleLike = requires { std::tuple_size<T>::value; };
+
+}
+
+// Default hash for members. Integers, enums and pointers are mixed directly, contiguous ranges of those, e.g.
+// strings, are hashed in bulk, tuples are hashed element-wise and everything else goes through std::hash.
+// Specialize for member types that are none of these.
+template<typename T>
+struct MemberHash {
+	std::size_t operator()(const T &value) const noexcept
+	{
+		if constexpr (detail::is_bitwise_comparable<T> && sizeof(T) > sizeof(std::uint64_t)) {
+			return detail::hashBytes(&value, sizeof(T));
+		} else if constexpr (detail::is_bitwise_comparable<T>) {
+			std::uint64_t bits = 0;
+			std::memcpy(&bits, &value, sizeof(T));
+			return detail::hashMix(bits ^ detail::hashSeed, detail::hashMultiplier);
+		} else if constexpr (detail::BitwiseContiguousRange<T>) {
+			return detail::hashBytes(std::ranges::data(value), std::ranges::size(value) * sizeof(std::ranges::range_value_t<const T>));
+		} else if constexpr (detail::TupleLike<T>) {
+			return std::apply([](const auto&... elements) {
+				std::uint64_t h = detail::hashSeed;
+				((h = detail::hashCombine(h, MemberHash<std::decay_t<decltype(elements)>>()(elements))), ...);
+				return h;
+			}, value);
+		} else {
+			static_assert(requires { std::hash<T>()(value); }, "No hash for this member type, specialize crampl::MemberHash.");
+			return detail::hashMix(std::hash<T>()(value) ^ detail::hashSeed, detail::hashMultiplier);
+		}
+	}
+};
+
+// PointerRanges are equal if their elements are, so their elements are hashed. With a custom Compare the
+// elements are only equivalent under that order, which has to be matched by a specialization.
+template<typename PointerType, typename Compare>
+struct MemberHash<PointerRange<PointerType, Compare>> {
+	std::size_t operator()(const PointerRange<PointerType, Compare> &range) const noexcept
+	{
+		using ValueType = std::decay_t<decltype(*std::declval<PointerType>())>;
+		static_assert(std::is_same_v<Compare, std::less<ValueType>>, "No hash for PointerRanges with a custom Compare, specialize crampl::MemberHash.");
+		if constexpr (detail::is_bitwise_comparable<ValueType>) {
+			return detail::hashBytes(range.begin, (range.end - range.begin) * sizeof(ValueType));
+		} else {
+			std::uint64_t h = detail::hashSeed;
+			for (PointerType it = range.begin; it != range.end; ++it)
+				h = detail::hashCombine(h, MemberHash<ValueType>()(*it));
+			return h;
+		}
+	}
+};
+
+// Default equality for members: operator== if available, otherwise equivalence according to operator<=>
+// or operator<, so that it agrees with MemberComparator for types that are only ordered.
+template<typename T>
+struct MemberEqualTo {
+	bool operator()(const T &lhs, const T &rhs) const
+	{
+		if constexpr (requires { lhs == rhs; })
+			return lhs == rhs;
+		else if constexpr (requires { lhs <=> rhs; })
+			return (lhs <=> rhs) == 0;
+		else
+			return !(lhs < rhs) && !(rhs < lhs);
+	}
+};
+
+namespace detail {
+
+// Checks whether the data members m... are laid out back to back in this order without padding, so that
+// they can be hashed or compared as one block of memory. Only depends on the type, so compilers fold it.
+template<typename ObjectType, auto m1, auto... m>
+bool membersContiguous(const ObjectType &object) noexcept
+{
+	const unsigned char *next = reinterpret_cast<const unsigned char*>(&(object.*m1)) + sizeof(object.*m1);
+	return ((reinterpret_cast<const unsigned char*>(&(object.*m)) == std::exchange(next, next + sizeof(object.*m))) && ...);
+}
+
+// Whether the members m... may be processed as one block of memory if they are contiguous.
+template<auto... m>
+constexpr bool bulkMembers = sizeof...(m) > 1 && (std::is_member_object_pointer_v<decltype(m)> && ...)
+	&& (is_bitwise_comparable<typename MemberWrapper<m>::valueType> && ...);
+
+template<auto... m>
+constexpr std::size_t bulkSize = (sizeof(typename MemberWrapper<m>::valueType) + ...);
+
+template<auto m1, auto... m, typename ObjectType>
+const void *firstMember(const ObjectType &object) noexcept
+{ return &(object.*m1); }
+
+// Helper class to hash members according to a hash template.
+// HashTemplate is the template used to instantiate the hash functors for the members.
+// ObjectType is the type of the hashed objects.
+// Args is a list of MemberWrapper<...> types, that wrap member specifiers.
+template<template<typename...> typename HashTemplate, typename ObjectType, typename... Args>
+struct MemberHasher;
+
+template<template<typename...> typename HashTemplate, typename ObjectType, auto... m>
+struct MemberHasher<HashTemplate, ObjectType, MemberWrapper<m>...> {
+	std::size_t operator()(const ObjectType &object) const noexcept
+	{
+		if constexpr (bulkMembers<m...> && std::is_same_v<HashTemplate<int>, MemberHash<int>>) {
+			if (membersContiguous<ObjectType, m...>(object))
+				return hashBytes(firstMember<m...>(object), bulkSize<m...>);
+		}
+		std::uint64_t h = hashSeed;
+		((h = hashCombine(h, HashTemplate<typename MemberWrapper<m>::valueType>()(MemberWrapper<m>::get(object)))), ...);
+		return h;
+	}
+};
+
+// Helper class to compare members for equality according to an equality template.
+template<template<typename...> typename EqualTemplate, typename ObjectType, typename... Args>
+struct MemberEqual;
+
+template<template<typename...> typename EqualTemplate, typename ObjectType, auto... m>
+struct MemberEqual<EqualTemplate, ObjectType, MemberWrapper<m>...> {
+	bool operator()(const ObjectType &lhs, const ObjectType &rhs) const
+	{
+		if constexpr (bulkMembers<m...> && std::is_same_v<EqualTemplate<int>, MemberEqualTo<int>>) {
+			if (membersContiguous<ObjectType, m...>(lhs))
+				return std::memcmp(firstMember<m...>(lhs), firstMember<m...>(rhs), bulkSize<m...>) == 0;
+		}
+		return (EqualTemplate<typename MemberWrapper<m>::valueType>()(MemberWrapper<m>::get(lhs), MemberWrapper<m>::get(rhs)) && ...);
+	}
+};
+
+}
+
+// Templated member hasher.
+// Hashes the members specified by M... using the hash template HashTemplate and combines the results.
+// Deduces the type of the object to be hashed from the list of member specifiers.
+template<template<typename...> typename HashTemplate, auto... M>
+using MemberHasherTemplate = detail::MemberHasher<HashTemplate, detail::ObjectType<M...>, detail::MemberWrapper<M>...>;
+
+// Default member hasher according to MemberHash. Contiguous integral, enum or pointer data members are hashed as one block.
+template<auto... M>
+using MemberHasher = MemberHasherTemplate<MemberHash, M...>;
+
+// Templated member equality.
+// Compares the members specified by M... for equality using the equality template EqualTemplate.
+template<template<typename...> typename EqualTemplate, auto... M>
+using MemberEqualTemplate = detail::MemberEqual<EqualTemplate, detail::ObjectType<M...>, detail::MemberWrapper<M>...>;
+
+// Default member equality according to MemberEqualTo, matching MemberHasher<M...>.
+template<auto... M>
+using MemberEqual = MemberEqualTemplate<MemberEqualTo, M...>;
+
+}
@@ -0,0 +1,261 @@
+/**
+ *
+ *
+ * @file MemberSort.h
+ * @brief Sorting algorithms ordering objects by selected members like MemberComparator.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <crampl/MemberComparator.h>
+#include <crampl/NormalizedKey.h>
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace crampl {
+
+namespace detail {
+
+template<typename Key>
+struct KeyedIndex {
+	Key key;
+	std::size_t index;
+};
+
+// Byte i of a fixed-width key, counted from the least significant byte.
+template<std::size_t Size>
+unsigned char keyByte(std::uint64_t key, std::size_t i) noexcept
+{ return static_cast<unsigned char>(key >> (i * CHAR_BIT)); }
+
+template<std::size_t Size>
+unsigned char keyByte(const std::array<unsigned char, Size> &key, std::size_t i) noexcept
+{ return key[Size - 1 - i]; }
+
+// Stable LSD radix sort of fixed-width keys, one pass per byte. All histograms are gathered in a single
+// pass, and passes in which all keys share the same byte are skipped.
+template<std::size_t Size, typename Key>
+void lsdRadixSort(std::vector<KeyedIndex<Key>> &items)
+{
+	std::vector<std::array<std::size_t, 256>> histograms(Size);
+	for (const auto &item : items)
+		for (std::size_t i = 0; i < Size; ++i)
+			++histograms[i][keyByte<Size>(item.key, i)];
+
+	std::vector<KeyedIndex<Key>> buffer(items.size());
+	for (std::size_t i = 0; i < Size; ++i) {
+		auto &histogram = histograms[i];
+		if (std::ranges::find(histogram, items.size()) != histogram.end())
+			continue;
+		std::size_t offset = 0;
+		for (std::size_t &count : histogram)
+			offset += std::exchange(count, offset);
+		for (auto &item : items)
+			buffer[histogram[keyByte<Size>(item.key, i)]++] = std::move(item);
+		items.swap(buffer);
+	}
+}
+
+// Stable MSD radix sort of byte string keys. Keys that end at the current depth form the first bucket;
+// small buckets are finished with a stable comparison sort. Bytes shared by all keys are skipped without
+// distributing the keys.
+inline void msdRadixSort(KeyedIndex<std::string> *first, KeyedIndex<std::string> *last, KeyedIndex<std::string> *buffer, std::size_t depth)
+{
+	constexpr std::ptrdiff_t comparisonSortThreshold = 64;
+	std::size_t n = static_cast<std::size_t>(last - first);
+	auto bucket = [&depth](const KeyedIndex<std::string> &item) -> std::size_t {
+		return depth < item.key.size() ? std::size_t(static_cast<unsigned char>(item.key[depth])) + 1 : 0;
+	};
+	std::array<std::size_t, 258> offsets;
+	for (;; ++depth) {
+		if (last - first <= comparisonSortThreshold) {
+			std::stable_sort(first, last, [depth](const auto &lhs, const auto &rhs) {
+				return lhs.key.compare(depth, std::string::npos, rhs.key, depth, std::string::npos) < 0;
+			});
+			return;
+		}
+		offsets.fill(0);
+		for (auto *item = first; item != last; ++item)
+			++offsets[bucket(*item) + 1];
+		if (offsets[1] == n)
+			return;
+		if (std::find(offsets.begin() + 2, offsets.end(), n) == offsets.end())
+			break;
+	}
+	for (std::size_t i = 1; i < offsets.size(); ++i)
+		offsets[i] += offsets[i - 1];
+	std::array<std::size_t, 258> bounds = offsets;
+	for (auto *item = first; item != last; ++item)
+		buffer[offsets[bucket(*item)]++] = std::move(*item);
+	std::move(buffer, buffer + n, first);
+	for (std::size_t i = 1; i + 1 < bounds.size(); ++i) {
+		if (bounds[i + 1] - bounds[i] > 1)
+			msdRadixSort(first + bounds[i], first + bounds[i + 1], buffer + bounds[i], depth + 1);
+	}
+}
+
+// Reorders [first, first + order.size()) so that the element at position i is the one previously at order[i].
+template<typename It>
+void applyOrder(It first, const std::vector<std::size_t> &order)
+{
+	std::vector<std::iter_value_t<It>> sorted;
+	sorted.reserve(order.size());
+	for (std::size_t index : order)
+		sorted.push_back(std::move(first[index]));
+	std::ranges::move(sorted, first);
+}
+
+// Value of member m computed once per element for sort_by_members. Members that MemberWrapper returns by
+// reference are kept as pointers into the element, everything else, e.g. results of getters or of
+// ConstructFromMembers, is stored by value.
+template<typename ObjectType, auto m>
+struct MemberProjection {
+	typedef typename MemberWrapper<m>::valueType valueType;
+	static constexpr bool byReference = std::is_reference_v<decltype(MemberWrapper<m>::get(std::declval<const ObjectType&>()))>;
+	typedef std::conditional_t<byReference, const valueType*, valueType> type;
+
+	static type project(const ObjectType &object)
+	{
+		if constexpr (byReference)
+			return &MemberWrapper<m>::get(object);
+		else
+			return MemberWrapper<m>::get(object);
+	}
+
+	static const valueType &value(const type &projection) noexcept
+	{
+		if constexpr (byReference)
+			return *projection;
+		else
+			return projection;
+	}
+};
+
+template<typename ObjectType, auto... m>
+struct ProjectedIndex {
+	std::tuple<typename MemberProjection<ObjectType, m>::type...> projections;
+	std::size_t index;
+};
+
+// Compares projected members like MemberComparator compares the members themselves. Ties are broken by
+// the original position, which makes the sort stable.
+template<template<typename...> typename CompareTemplate, typename ObjectType, auto... m>
+struct ProjectionComparator {
+	bool operator()(const ProjectedIndex<ObjectType, m...> &lhs, const ProjectedIndex<ObjectType, m...> &rhs) const
+	{
+		return compare(lhs, rhs, std::index_sequence_for<decltype(m)...>());
+	}
+
+private:
+	template<std::size_t... I>
+	static bool compare(const ProjectedIndex<ObjectType, m...> &lhs, const ProjectedIndex<ObjectType, m...> &rhs, std::index_sequence<I...>)
+	{
+		int order = 0;
+		static_cast<void>((((order = compareMember<m, I>(lhs, rhs)) != 0) || ...));
+		return order != 0 ? order < 0 : lhs.index < rhs.index;
+	}
+
+	template<auto member, std::size_t I>
+	static int compareMember(const ProjectedIndex<ObjectType, m...> &lhs, const ProjectedIndex<ObjectType, m...> &rhs)
+	{
+		using Projection = MemberProjection<ObjectType, member>;
+		CompareTemplate<typename Projection::valueType> cmp;
+		const auto &l = Projection::value(std::get<I>(lhs.projections));
+		const auto &r = Projection::value(std::get<I>(rhs.projections));
+		if (cmp(l, r)) return -1;
+		if (cmp(r, l)) return 1;
+		return 0;
+	}
+};
+
+template<template<typename...> typename CompareTemplate, auto... M, typename It>
+void sortByProjections(It first, It last)
+{
+	using ObjectType = detail::ObjectType<M...>;
+	using Item = ProjectedIndex<ObjectType, M...>;
+	std::size_t n = static_cast<std::size_t>(last - first);
+	if (n < 2)
+		return;
+
+	std::vector<Item> items;
+	items.reserve(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		const ObjectType &object = first[i];
+		items.push_back(Item{{MemberProjection<ObjectType, M>::project(object)...}, i});
+	}
+	std::sort(items.begin(), items.end(), ProjectionComparator<CompareTemplate, ObjectType, M...>());
+
+	std::vector<std::size_t> order;
+	order.reserve(n);
+	for (const Item &item : items)
+		order.push_back(item.index);
+	applyOrder(first, order);
+}
+
+}
+
+// Sorts [first, last) in the order of MemberComparator<M...> by decorate-sort-undecorate: the members are
+// computed once per element into a key array together with the element's position, the key array is
+// sorted and the elements are then moved into place once. Worthwhile if the members are getters or
+// ConstructFromMembers, which MemberComparator re-evaluates on every comparison. The sort is stable.
+template<auto... M, std::random_access_iterator It>
+void sort_by_members(It first, It last)
+{ detail::sortByProjections<std::less, M...>(first, last); }
+
+template<auto... M, std::ranges::random_access_range Range>
+void sort_by_members(Range &&range)
+{ sort_by_members<M...>(std::ranges::begin(range), std::ranges::end(range)); }
+
+// Sorts [first, last) in the order of MemberComparatorTemplate<CompareTemplate, M...> by decorate-sort-undecorate.
+template<template<typename...> typename CompareTemplate, auto... M, std::random_access_iterator It>
+void sort_by_members(It first, It last)
+{ detail::sortByProjections<CompareTemplate, M...>(first, last); }
+
+template<template<typename...> typename CompareTemplate, auto... M, std::ranges::random_access_range Range>
+void sort_by_members(Range &&range)
+{ sort_by_members<CompareTemplate, M...>(std::ranges::begin(range), std::ranges::end(range)); }
+
+// Sorts [first, last) in the order of MemberComparator<M...> by radix sorting the NormalizedKeys of the
+// elements and then moving each element into place once. The sort is stable.
+template<auto... M, std::random_access_iterator It>
+void radix_sort_by_members(It first, It last)
+{
+	using Key = NormalizedKey<M...>;
+	using Item = detail::KeyedIndex<typename Key::type>;
+	std::size_t n = static_cast<std::size_t>(last - first);
+	if (n < 2)
+		return;
+
+	std::vector<Item> items;
+	items.reserve(n);
+	for (std::size_t i = 0; i < n; ++i)
+		items.push_back(Item{Key::get(first[i]), i});
+
+	if constexpr (Key::fixedWidth) {
+		detail::lsdRadixSort<Key::size>(items);
+	} else {
+		std::vector<Item> buffer(n);
+		detail::msdRadixSort(items.data(), items.data() + n, buffer.data(), 0);
+	}
+
+	std::vector<std::size_t> order;
+	order.reserve(n);
+	for (const Item &item : items)
+		order.push_back(item.index);
+	detail::applyOrder(first, order);
+}
+
+template<auto... M, std::ranges::random_access_range Range>
+void radix_sort_by_members(Range &&range)
+{ radix_sort_by_members<M...>(std::ranges::begin(range), std::ranges::end(range)); }
+
+}
@@ -9,17 +9,61 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <optional>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <ranges>
+#include <vector>
 
 namespace crampl {
 
 template<typename Key, typename...>
 struct ComplexKey {};
 
+// Composite key of a flat MultiKeyMap level: several keys stored as a single map key, so that
+// one probe resolves all of them.
+template<typename... Keys>
+struct CompositeKey : std::tuple<Keys...> {
+    using std::tuple<Keys...>::tuple;
+
+    // Constructs each key from the corresponding tuple of constructor arguments.
+    template<typename... KeyArgs>
+    CompositeKey(std::piecewise_construct_t, KeyArgs&&... keyArgs)
+        : std::tuple<Keys...>(std::make_from_tuple<Keys>(std::forward<KeyArgs>(keyArgs))...) {}
+
+    // Allocator-extended variant for uses-allocator construction, e.g. in std::pmr maps.
+    template<typename Alloc, typename... KeyArgs>
+    CompositeKey(std::allocator_arg_t, const Alloc& alloc, std::piecewise_construct_t, KeyArgs&&... keyArgs)
+        : std::tuple<Keys...>(std::allocator_arg, alloc, std::apply([&](auto&&... args) {
+            return std::make_obj_using_allocator<Keys>(alloc, static_cast<decltype(args)>(args)...);
+        }, std::forward<KeyArgs>(keyArgs))...) {}
+
+    friend auto operator<=>(const CompositeKey&, const CompositeKey&) = default;
+    friend bool operator==(const CompositeKey&, const CompositeKey&) = default;
+
+    // Heterogeneous comparison against a tuple of (references to) keys, used for lookups through
+    // transparent comparators.
+    template<typename... Others> requires (sizeof...(Others) == sizeof...(Keys))
+    friend auto operator<=>(const CompositeKey& lhs, const std::tuple<Others...>& rhs) {
+        return static_cast<const std::tuple<Keys...>&>(lhs) <=> rhs;
+    }
+    template<typename... Others> requires (sizeof...(Others) == sizeof...(Keys))
+    friend bool operator==(const CompositeKey& lhs, const std::tuple<Others...>& rhs) {
+        return static_cast<const std::tuple<Keys...>&>(lhs) == rhs;
+    }
+};
+
 namespace detail {
 
+inline std::size_t hash_combine(std::size_t seed, std::size_t hash) noexcept {
+    return seed ^ (hash + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
 template<template<typename...> typename MapKind, typename... KeyTypes___And___ValueType>
 struct MultiKeyMap;
 
@@ -42,27 +86,139 @@ template<template<typename...> typename MapKind, typename Key, typename Value, t
 struct MultiKeyMap<MapKind, ComplexKey<Key, Tail...>, Value> {
     using type = MapKind<Key, Value, Tail...>;
 };
+
+// Collects all key types into a single CompositeKey.
+template<template<typename...> typename MapKind, typename Keys, typename... KeyTypes___And___ValueType>
+struct FlatMultiKeyMap;
+
+template<template<typename...> typename MapKind, typename... Keys, typename Key, typename Next, typename... KeyTypes___And___ValueType>
+struct FlatMultiKeyMap<MapKind, CompositeKey<Keys...>, Key, Next, KeyTypes___And___ValueType...>
+    : FlatMultiKeyMap<MapKind, CompositeKey<Keys..., Key>, Next, KeyTypes___And___ValueType...> {};
+
+template<template<typename...> typename MapKind, typename... Keys, typename Value>
+struct FlatMultiKeyMap<MapKind, CompositeKey<Keys...>, Value> {
+    using type = MapKind<CompositeKey<Keys...>, Value>;
+};
+
+// Number of keys consumed by one level of a MultiKeyMap.
+template<typename Key>
+struct KeyArity : std::integral_constant<std::size_t, 1> {};
+
+template<typename... Keys>
+struct KeyArity<CompositeKey<Keys...>> : std::integral_constant<std::size_t, sizeof...(Keys)> {};
+
+template<typename Map>
+constexpr std::size_t keyArity = KeyArity<typename std::remove_cvref_t<Map>::key_type>::value;
+
+template<typename T>
+concept MapLevel = requires {
+    typename std::remove_cvref_t<T>::key_type;
+    typename std::remove_cvref_t<T>::mapped_type;
+};
+
+// Mapped type of a map, const if the map is const.
+template<typename Map>
+using Mapped = std::conditional_t<std::is_const_v<Map>, const typename Map::mapped_type, typename Map::mapped_type>;
+
+// Number of nested map levels, i.e. all levels up to the first mapped type that is not a map itself.
+template<typename Map>
+constexpr std::size_t mapDepth() {
+    if constexpr (MapLevel<Mapped<Map>>) {
+        return 1 + mapDepth<Mapped<Map>>();
+    } else {
+        return 1;
+    }
+}
+
+template<typename Map, std::size_t I>
+struct LevelType {
+    using type = typename LevelType<Mapped<Map>, I - 1>::type;
+};
+
+template<typename Map>
+struct LevelType<Map, 0> {
+    using type = Map;
+};
+
+// Calls f with a tuple of the first N arguments followed by the remaining arguments.
+template<std::size_t N, typename F, typename... Args>
+decltype(auto) splitArgs(F&& f, Args&&... args) {
+    auto all = std::forward_as_tuple(std::forward<Args>(args)...);
+    return [&]<std::size_t... I, std::size_t... J>(std::index_sequence<I...>, std::index_sequence<J...>) -> decltype(auto) {
+        return std::forward<F>(f)(std::forward_as_tuple(std::get<I>(std::move(all))...), std::get<N + J>(std::move(all))...);
+    }(std::make_index_sequence<N>{}, std::make_index_sequence<sizeof...(Args) - N>{});
+}
+
+// Whether the map accepts keys of other types than its key_type for lookup.
+template<typename Map>
+concept TransparentLookup = requires {
+    typename std::remove_cvref_t<Map>::key_compare::is_transparent;
+} || requires {
+    typename std::remove_cvref_t<Map>::hasher::is_transparent;
+    typename std::remove_cvref_t<Map>::key_equal::is_transparent;
+};
+
+// Builds the lookup key of one map level from a tuple of keys. Keys are passed on as they are, so
+// that transparent maps can look them up without constructing a key_type.
+template<typename Map, typename... Keys>
+decltype(auto) levelKey(std::tuple<Keys...>&& keys) {
+    if constexpr (keyArity<Map> == 1) {
+        return std::get<0>(std::move(keys));
+    } else if constexpr (TransparentLookup<Map>) {
+        return std::move(keys);
+    } else {
+        return std::make_from_tuple<typename std::remove_cvref_t<Map>::key_type>(std::move(keys));
+    }
+}
+
+// Builds the piecewise constructor arguments of the key of one map level from a tuple of key argument tuples.
+template<typename Map, typename... KeyArgs>
+decltype(auto) levelKeyArgs(std::tuple<KeyArgs...>&& keyArgs) {
+    if constexpr (keyArity<Map> == 1) {
+        return std::get<0>(std::move(keyArgs));
+    } else {
+        return std::apply([](auto&&... args) {
+            return std::forward_as_tuple(std::piecewise_construct, static_cast<decltype(args)>(args)...);
+        }, std::move(keyArgs));
+    }
+}
+
 }
 
 
 template<template<typename...> typename MapKind, typename... KeyTypes_AND_ValueType>
 using MultiKeyMap = typename detail::MultiKeyMap<MapKind, KeyTypes_AND_ValueType...>::type;
 
+// Flat variant of MultiKeyMap: a single MapKind keyed by a CompositeKey of all key types.
+// Works with the same variadic find and emplace calls as a nested MultiKeyMap; CompositeKey
+// can also be used as a single level of a nested MultiKeyMap.
+template<template<typename...> typename MapKind, typename... KeyTypes_AND_ValueType>
+using FlatMultiKeyMap = typename detail::FlatMultiKeyMap<MapKind, CompositeKey<>, KeyTypes_AND_ValueType...>::type;
 
-template<typename A, typename B, typename... C>
-auto find(A&& map, B&& key, C&&... keys)
+
+// Returns a pointer to the value stored under the given keys, or nullptr if there is none.
+// If fewer keys than levels are given, returns a pointer to the inner map instead.
+// Probes each level once and neither copies the value nor, for transparent maps, converts the keys.
+template<typename A, typename... B>
+auto find_ptr(A& map, B&&... keys)
 {
-    if constexpr (sizeof...(keys) > 0) {
-        auto it = map.find(key);
-        if (it == map.end())
-            return std::optional<decltype(find(it->second, keys...))>{};
-        return std::make_optional(find(it->second, keys...));
-    } else {
-        auto it = map.find(key);
-        if (map.find(key) == map.end())
-            return std::optional<decltype(it->second)>{};
-        return std::make_optional(it->second);
-    }
+    return detail::splitArgs<detail::keyArity<A>>([&](auto&& key, auto&&... tail) {
+        auto it = map.find(detail::levelKey<A>(std::move(key)));
+        if constexpr (sizeof...(tail) > 0) {
+            return it == map.end() ? nullptr : find_ptr(it->second, static_cast<decltype(tail)>(tail)...);
+        } else {
+            return it == map.end() ? nullptr : std::addressof(it->second);
+        }
+    }, std::forward<B>(keys)...);
+}
+
+// Returns a copy of the value stored under the given keys, if any.
+template<typename A, typename... B>
+auto find(A&& map, B&&... keys)
+{
+    auto* value = find_ptr(map, std::forward<B>(keys)...);
+    using Value = std::remove_cvref_t<decltype(*value)>;
+    return value ? std::optional<Value>{*value} : std::optional<Value>{};
 }
 
 template<typename T>
@@ -83,20 +239,238 @@ auto operator+(compose<Lambda1> lhs, compose<Lambda2> rhs)
 }
 
 
-template<typename A,  typename... B>
+template<typename A, typename... B>
 auto& emplace(A& map, std::piecewise_construct_t, B&&... keys) {
-    return [&]<auto... Ix>(std::index_sequence<Ix...>) -> decltype(auto) {
-        return std::get<0>((... + compose{[&](auto& inner, auto&& key, auto&&... args) mutable -> decltype(auto) {
-            static_cast<void>(Ix);
-            if constexpr (sizeof...(args) == 1) {
-                auto [it, _] = inner.emplace(std::piecewise_construct, static_cast<decltype(key)>(key), static_cast<decltype(args)>(args)...);
-                return std::make_tuple(std::ref(it->second), std::nullopt);
+    return detail::splitArgs<detail::keyArity<A>>([&](auto&& key, auto&&... args) -> auto& {
+        if constexpr (sizeof...(args) == 1) {
+            auto [it, _] = map.emplace(std::piecewise_construct, detail::levelKeyArgs<A>(std::move(key)), static_cast<decltype(args)>(args)...);
+            return it->second;
+        } else {
+            auto [it, _] = map.emplace(std::piecewise_construct, detail::levelKeyArgs<A>(std::move(key)), std::forward_as_tuple());
+            return emplace(it->second, std::piecewise_construct, static_cast<decltype(args)>(args)...);
+        }
+    }, std::forward<B>(keys)...);
+}
+
+// Erases the value stored under the given keys or, if fewer keys than levels are given, the whole inner
+// map below them. Inner maps that are left empty are erased as well, in the same walk down the levels.
+// Returns whether anything was erased.
+template<typename A, typename... B>
+bool erase(A& map, B&&... keys) {
+    return detail::splitArgs<detail::keyArity<A>>([&](auto&& key, auto&&... tail) {
+        auto it = map.find(detail::levelKey<A>(std::move(key)));
+        if (it == map.end())
+            return false;
+        if constexpr (sizeof...(tail) > 0) {
+            if (!erase(it->second, static_cast<decltype(tail)>(tail)...))
+                return false;
+            if (it->second.empty())
+                map.erase(it);
+        } else {
+            map.erase(it);
+        }
+        return true;
+    }, std::forward<B>(keys)...);
+}
+
+namespace detail {
+
+// Builds one level of a MultiKeyMap from a sorted range of (key..., value) tuples.
+// Offset is the position of the first key of this level within the tuples.
+template<typename Map, typename Element, std::size_t Offset = 0>
+struct BulkLoader {
+    static constexpr std::size_t arity = keyArity<Map>;
+    static constexpr bool isLeaf = Offset + arity + 1 == std::tuple_size_v<Element>;
+
+    template<typename T>
+    static auto keys(T& element) {
+        return [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::tie(std::get<Offset + I>(element)...);
+        }(std::make_index_sequence<arity>{});
+    }
+
+    // Orders elements by the keys of this level only.
+    static bool less(const Element& lhs, const Element& rhs) {
+        if constexpr (arity == 1 && requires { typename Map::key_compare; }) {
+            return typename Map::key_compare{}(std::get<Offset>(lhs), std::get<Offset>(rhs));
+        } else {
+            return keys(lhs) < keys(rhs);
+        }
+    }
+
+    // Orders elements by the keys of this and all inner levels.
+    static bool fullLess(const Element& lhs, const Element& rhs) {
+        if (less(lhs, rhs)) return true;
+        if (less(rhs, lhs)) return false;
+        if constexpr (isLeaf) {
+            return false;
+        } else {
+            return BulkLoader<typename Map::mapped_type, Element, Offset + arity>::fullLess(lhs, rhs);
+        }
+    }
+
+    template<typename It>
+    static void load(Map& map, It first, It last) {
+        while (first != last) {
+            It groupEnd = std::find_if(std::next(first), last, [&](const Element& element) {
+                return less(*first, element);
+            });
+            if constexpr (isLeaf) {
+                map.emplace_hint(map.end(), std::piecewise_construct, keys(*first),
+                                 std::forward_as_tuple(std::move(std::get<Offset + arity>(*first))));
             } else {
-                auto [it, _] = inner.emplace(std::piecewise_construct, static_cast<decltype(key)>(key), std::forward_as_tuple());
-                return std::make_tuple(std::ref(it->second), static_cast<decltype(args)>(args)...);
+                auto it = map.emplace_hint(map.end(), std::piecewise_construct, keys(*first), std::forward_as_tuple());
+                BulkLoader<typename Map::mapped_type, Element, Offset + arity>::load(it->second, first, groupEnd);
+            }
+            first = groupEnd;
+        }
+    }
+};
+
+}
+
+// Inserts a range of (key..., value) tuples that is sorted by the keys of all levels, e.g. by bulk_load.
+// Each level is built with end-hinted inserts in a single pass over the range. Values are moved out of
+// the range; as with emplace, the first of several entries with the same keys wins.
+template<typename A, typename It>
+void bulk_load_sorted(A& map, It first, It last) {
+    detail::BulkLoader<A, std::iter_value_t<It>>::load(map, first, last);
+}
+
+// Sorts a range of (key..., value) tuples once and inserts it with bulk_load_sorted.
+// Ordered levels are sorted by their default constructed key_compare, all other levels by operator<.
+template<typename A, std::ranges::random_access_range Range>
+void bulk_load(A& map, Range&& range) {
+    using Element = std::ranges::range_value_t<Range>;
+    std::ranges::stable_sort(range, detail::BulkLoader<A, Element>::fullLess);
+    bulk_load_sorted(map, std::ranges::begin(range), std::ranges::end(range));
+}
+
+namespace detail {
+
+inline void prefetch(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#endif
+}
+
+// Lets maps that can compute where a lookup will land, e.g. FlatHashMap, fetch that memory early.
+template<typename Map, typename Key>
+void prefetchLookup(const Map& map, const Key& key) {
+    if constexpr (requires { map.prefetch(key); }) {
+        map.prefetch(key);
+    }
+}
+
+// Resolves one level of a batch of lookups. Lookups are visited in order, consecutive ones with
+// equal keys on this level share a single probe. All probes of a level are prefetched before the
+// first of them is made, so that their cache misses overlap instead of adding up.
+// Offset is the position of the first key of this level within the key tuples.
+template<typename Map, typename KeyTuple, std::size_t Offset = 0>
+struct BatchFinder {
+    static constexpr std::size_t arity = keyArity<Map>;
+    static constexpr bool isLeaf = Offset + arity == std::tuple_size_v<KeyTuple>;
+    static_assert(Offset + arity <= std::tuple_size_v<KeyTuple>, "Key tuples end within a composite level.");
+
+    using Inner = Mapped<Map>;
+
+    // Lookups [first, last) of the batch order, all below the same map of this level.
+    struct Group {
+        std::size_t first;
+        std::size_t last;
+        Map* map;
+    };
+
+    static auto keys(const KeyTuple& element) {
+        return [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::forward_as_tuple(std::get<Offset + I>(element)...);
+        }(std::make_index_sequence<arity>{});
+    }
+
+    template<typename KeyAt>
+    static Inner* lookup(const Group& run, KeyAt& keyAt) {
+        auto it = run.map->find(levelKey<Map>(keys(keyAt(run.first))));
+        return it == run.map->end() ? nullptr : std::addressof(it->second);
+    }
+
+    template<typename KeyAt, typename Result>
+    static std::size_t find(const std::vector<Group>& groups, KeyAt&& keyAt, Result&& result) {
+        std::vector<Group> runs;
+        runs.reserve(groups.size());
+        for (const Group& group : groups) {
+            for (std::size_t i = group.first; i < group.last;) {
+                auto key = keys(keyAt(i));
+                std::size_t j = i + 1;
+                while (j < group.last && keys(keyAt(j)) == key)
+                    ++j;
+                prefetchLookup(*group.map, levelKey<Map>(std::move(key)));
+                runs.push_back({i, j, group.map});
+                i = j;
+            }
+        }
+
+        std::size_t found = 0;
+        if constexpr (isLeaf) {
+            for (const Group& run : runs) {
+                Inner* value = lookup(run, keyAt);
+                for (std::size_t i = run.first; i < run.last; ++i)
+                    result(i, value);
+                found += value ? run.last - run.first : 0;
+            }
+        } else {
+            using InnerFinder = BatchFinder<Inner, KeyTuple, Offset + arity>;
+            std::vector<typename InnerFinder::Group> next;
+            for (const Group& run : runs) {
+                if (Inner* inner = lookup(run, keyAt)) {
+                    prefetch(inner);
+                    next.push_back({run.first, run.last, inner});
+                } else {
+                    for (std::size_t i = run.first; i < run.last; ++i)
+                        result(i, nullptr);
+                }
             }
-        }}).lambda(map, std::forward<B>(keys)...));
-    }(std::make_index_sequence<sizeof...(keys) - 1>{});
+            if (!next.empty())
+                found = InnerFinder::find(next, keyAt, result);
+        }
+        return found;
+    }
+};
+
+template<typename Tuple>
+constexpr bool totallyOrderedElements = [] {
+    return []<std::size_t... I>(std::index_sequence<I...>) {
+        return (std::totally_ordered<std::tuple_element_t<I, Tuple>> && ...);
+    }(std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+}();
+
+}
+
+// Looks up a whole batch of key tuples, writing to each position of results what find_ptr would return
+// for the key tuple at the same position: a pointer to the value (or, for partial key tuples, to the
+// inner map) or nullptr. Returns the number of lookups that found something. results must have at least as
+// many elements as keys.
+// The batch is walked level by level in key order, so lookups sharing a key prefix share its probes,
+// and the probes of each level are prefetched together. If not all keys are totally ordered, the
+// batch is walked in the given order and only adjacent lookups share probes.
+template<typename A, std::ranges::random_access_range Keys, std::ranges::random_access_range Results>
+    requires std::ranges::sized_range<const Keys> && std::ranges::sized_range<Results>
+std::size_t find_batch(A& map, const Keys& keys, Results&& results)
+{
+    using KeyTuple = std::ranges::range_value_t<Keys>;
+    std::size_t size = std::ranges::size(keys);
+    assert(std::ranges::size(results) >= size && "find_batch needs a result slot for every key tuple.");
+    std::vector<std::size_t> order(size);
+    for (std::size_t i = 0; i < size; ++i)
+        order[i] = i;
+    auto keyAt = [&](std::size_t i) -> const KeyTuple& { return std::ranges::begin(keys)[order[i]]; };
+    if constexpr (detail::totallyOrderedElements<KeyTuple>) {
+        std::ranges::sort(order, std::less<>{}, [&](std::size_t i) -> const KeyTuple& {
+            return std::ranges::begin(keys)[i];
+        });
+    }
+    auto result = [&](std::size_t i, auto value) { std::ranges::begin(results)[order[i]] = value; };
+    using Finder = detail::BatchFinder<A, KeyTuple>;
+    return size ? Finder::find({{0, size, std::addressof(map)}}, keyAt, result) : 0;
 }
 
 /*
@@ -145,3 +519,23 @@ auto& emplace(A& map, std::piecewise_construct_t, B1&& _key1, B&&... keys) {
  */
 
 }
+
+template<typename... Keys>
+struct std::tuple_size<crampl::CompositeKey<Keys...>> : std::integral_constant<std::size_t, sizeof...(Keys)> {};
+
+template<std::size_t I, typename... Keys>
+struct std::tuple_element<I, crampl::CompositeKey<Keys...>> : std::tuple_element<I, std::tuple<Keys...>> {};
+
+template<typename... Keys, typename Alloc>
+struct std::uses_allocator<crampl::CompositeKey<Keys...>, Alloc> : std::true_type {};
+
+template<typename... Keys>
+struct std::hash<crampl::CompositeKey<Keys...>> {
+    std::size_t operator()(const crampl::CompositeKey<Keys...>& key) const noexcept {
+        return std::apply([](const Keys&... keys) {
+            std::size_t seed = 0;
+            ((seed = crampl::detail::hash_combine(seed, std::hash<Keys>{}(keys))), ...);
+            return seed;
+        }, static_cast<const std::tuple<Keys...>&>(key));
+    }
+};
@@ -0,0 +1,343 @@
+/**
+ *
+ *
+ * @file MultiKeyMapSnapshot.h
+ * @brief Flat, offset-based on-disk snapshots of MultiKeyMaps and a zero-copy read-only view over them.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CRAMPL_HAS_MMAP 1
+#endif
+
+#include "MultiKeyMap.h"
+
+namespace crampl {
+
+// Snapshot layout (native endianness, all offsets relative to the start of the snapshot):
+//   Header   magic, layout fingerprint
+//   Nodes    one per (inner) map, children before their parents:
+//            std::uint64_t count, Key keys[count] sorted by std::less<Key>,
+//            then std::uint64_t childOffsets[count] or, on the last level, Value values[count],
+//            each array aligned to its element type
+//   Trailer  offset of the root node, magic
+// Lookups binary search the key array of each level, so the snapshot can be used in place, e.g. mmapped.
+
+namespace detail {
+
+inline constexpr std::array<char, 8> snapshotMagic { 'C', 'R', 'A', 'M', 'P', 'L', 'S', '1' };
+
+struct SnapshotHeader {
+    std::array<char, 8> magic;
+    std::uint64_t layout;
+};
+
+struct SnapshotTrailer {
+    std::uint64_t root;
+    std::array<char, 8> magic;
+};
+
+// Key types of all levels and the value type of a nested MultiKeyMap.
+template<typename Map>
+struct SnapshotLayout {
+    static constexpr std::size_t depth = mapDepth<Map>();
+
+    template<std::size_t I>
+    using Key = typename LevelType<Map, I>::type::key_type;
+    using Value = typename LevelType<Map, depth - 1>::type::mapped_type;
+
+    static constexpr std::size_t alignment = [] {
+        return [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::max({alignof(std::uint64_t), alignof(Value), alignof(Key<I>)...});
+        }(std::make_index_sequence<depth>{});
+    }();
+
+    static constexpr bool trivial = [] {
+        return [&]<std::size_t... I>(std::index_sequence<I...>) {
+            return std::is_trivially_copyable_v<Value> && (std::is_trivially_copyable_v<Key<I>> && ...);
+        }(std::make_index_sequence<depth>{});
+    }();
+
+    // Fingerprint of the sizes and alignments of all types, checked when a snapshot is opened.
+    static constexpr std::uint64_t fingerprint() {
+        std::uint64_t result = depth;
+        auto mix = [&](std::size_t size, std::size_t align) {
+            result = result * 0x100000001b3ull ^ (size << 8 | align);
+        };
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (mix(sizeof(Key<I>), alignof(Key<I>)), ...);
+        }(std::make_index_sequence<depth>{});
+        mix(sizeof(Value), alignof(Value));
+        return result;
+    }
+
+    static constexpr std::uint64_t align(std::uint64_t offset, std::size_t alignment) {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    // Offsets of the key array and the child offset or value array relative to their node.
+    template<std::size_t I>
+    static constexpr std::pair<std::uint64_t, std::uint64_t> nodeOffsets(std::uint64_t count) {
+        using Entry = std::conditional_t<I + 1 == depth, Value, std::uint64_t>;
+        std::uint64_t keys = align(sizeof(std::uint64_t), alignof(Key<I>));
+        std::uint64_t entries = align(keys + count * sizeof(Key<I>), alignof(Entry));
+        return {keys, entries};
+    }
+};
+
+template<typename Map>
+class SnapshotWriter {
+    using Layout = SnapshotLayout<Map>;
+
+public:
+    explicit SnapshotWriter(std::ostream& out): out(out) {}
+
+    void write(const Map& map) {
+        put(SnapshotHeader{snapshotMagic, Layout::fingerprint()});
+        std::uint64_t root = writeNode<0>(map);
+        pad(Layout::align(position, alignof(SnapshotTrailer)));
+        put(SnapshotTrailer{root, snapshotMagic});
+        if (!out)
+            throw std::runtime_error("crampl: failed to write snapshot");
+    }
+
+private:
+    template<std::size_t I, typename Level>
+    std::uint64_t writeNode(const Level& level) {
+        using Key = typename Layout::template Key<I>;
+        std::vector<const typename Level::value_type*> sorted;
+        sorted.reserve(level.size());
+        for (const auto& entry : level)
+            sorted.push_back(std::addressof(entry));
+        std::sort(sorted.begin(), sorted.end(), [](const auto* lhs, const auto* rhs) {
+            return std::less<Key>{}(lhs->first, rhs->first);
+        });
+
+        std::vector<std::uint64_t> children;
+        if constexpr (I + 1 < Layout::depth) {
+            children.reserve(sorted.size());
+            for (const auto* entry : sorted)
+                children.push_back(writeNode<I + 1>(entry->second));
+        }
+
+        pad(Layout::align(position, Layout::alignment));
+        std::uint64_t node = position;
+        auto [keys, entries] = Layout::template nodeOffsets<I>(sorted.size());
+        put(std::uint64_t(sorted.size()));
+        pad(node + keys);
+        for (const auto* entry : sorted)
+            put(entry->first);
+        pad(node + entries);
+        if constexpr (I + 1 < Layout::depth) {
+            for (std::uint64_t child : children)
+                put(child);
+        } else {
+            for (const auto* entry : sorted)
+                put(entry->second);
+        }
+        return node;
+    }
+
+    template<typename T>
+    void put(const T& value) {
+        out.write(reinterpret_cast<const char*>(std::addressof(value)), sizeof(T));
+        position += sizeof(T);
+    }
+
+    void pad(std::uint64_t target) {
+        static constexpr char zeros[64] = {};
+        while (position < target) {
+            std::uint64_t count = std::min<std::uint64_t>(target - position, sizeof(zeros));
+            out.write(zeros, static_cast<std::streamsize>(count));
+            position += count;
+        }
+    }
+
+    std::ostream& out;
+    std::uint64_t position = 0;
+};
+
+#ifdef CRAMPL_HAS_MMAP
+// Read-only memory mapping of a whole file.
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "crampl: failed to open " + path.string());
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "crampl: failed to stat " + path.string());
+        }
+        size = static_cast<std::size_t>(info.st_size);
+        if (size > 0) {
+            data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            if (data == MAP_FAILED) {
+                int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "crampl: failed to map " + path.string());
+            }
+        }
+        ::close(fd);
+    }
+    MappedFile(MappedFile&& other) noexcept: data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)) {}
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        std::swap(data, other.data);
+        std::swap(size, other.size);
+        return *this;
+    }
+    ~MappedFile() {
+        if (data)
+            ::munmap(data, size);
+    }
+
+    std::span<const std::byte> bytes() const {
+        return {static_cast<const std::byte*>(data), size};
+    }
+
+private:
+    void* data = nullptr;
+    std::size_t size = 0;
+};
+#endif
+
+}
+
+// Writes a nested MultiKeyMap with trivially copyable keys and values as a snapshot that
+// MultiKeyMapSnapshot can answer lookups from without deserializing it.
+template<typename Map>
+void write_snapshot(const Map& map, std::ostream& out) {
+    static_assert(detail::SnapshotLayout<Map>::trivial, "Snapshots require trivially copyable keys and values.");
+    detail::SnapshotWriter<Map>(out).write(map);
+}
+
+template<typename Map>
+void write_snapshot(const Map& map, const std::filesystem::path& path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw std::runtime_error("crampl: failed to create " + path.string());
+    write_snapshot(map, out);
+}
+
+// Read-only view of a snapshot written by write_snapshot for the same Map type. Opened from a file, the
+// snapshot is mmapped, so opening is constant time and processes share the page cache. Lookups only
+// touch the nodes on their path. Only the header, trailer and type fingerprint are validated, so
+// snapshots must come from a trusted source.
+template<typename Map>
+class MultiKeyMapSnapshot {
+    using Layout = detail::SnapshotLayout<Map>;
+
+public:
+    using value_type = typename Layout::Value;
+
+#ifdef CRAMPL_HAS_MMAP
+    explicit MultiKeyMapSnapshot(const std::filesystem::path& path): file(detail::MappedFile(path)) {
+        open(file->bytes());
+    }
+#endif
+
+    // Views a snapshot in memory, which must be aligned suitably for the keys and values and outlive the view.
+    explicit MultiKeyMapSnapshot(std::span<const std::byte> bytes) {
+        open(bytes);
+    }
+
+    // Returns a pointer to the value stored under the given keys, or nullptr if there is none.
+    template<typename... Keys>
+    const value_type* find_ptr(const Keys&... keys) const {
+        static_assert(sizeof...(Keys) == Layout::depth, "Snapshot lookups need one key per level.");
+        return findNode<0>(root, keys...);
+    }
+
+private:
+    void open(std::span<const std::byte> bytes) {
+        data = bytes.data();
+        if (reinterpret_cast<std::uintptr_t>(data) % Layout::alignment)
+            throw std::runtime_error("crampl: misaligned snapshot");
+        if (bytes.size() < sizeof(detail::SnapshotHeader) + sizeof(detail::SnapshotTrailer))
+            throw std::runtime_error("crampl: truncated snapshot");
+        detail::SnapshotHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        detail::SnapshotTrailer trailer;
+        std::memcpy(&trailer, data + bytes.size() - sizeof(trailer), sizeof(trailer));
+        if (header.magic != detail::snapshotMagic || trailer.magic != detail::snapshotMagic)
+            throw std::runtime_error("crampl: not a snapshot");
+        if (header.layout != Layout::fingerprint())
+            throw std::runtime_error("crampl: snapshot was written for different key or value types");
+        if (trailer.root >= bytes.size() - sizeof(trailer))
+            throw std::runtime_error("crampl: corrupt snapshot");
+        root = trailer.root;
+    }
+
+    template<std::size_t I, typename K, typename... Keys>
+    const value_type* findNode(std::uint64_t node, const K& key, const Keys&... keys) const {
+        using Key = typename Layout::template Key<I>;
+        const std::byte* base = data + node;
+        std::uint64_t count = *reinterpret_cast<const std::uint64_t*>(base);
+        auto [keysOffset, entriesOffset] = Layout::template nodeOffsets<I>(count);
+        const Key* first = reinterpret_cast<const Key*>(base + keysOffset);
+        const Key* last = first + count;
+        const Key* it = std::lower_bound(first, last, key, std::less<Key>{});
+        if (it == last || std::less<Key>{}(key, *it))
+            return nullptr;
+        std::size_t index = static_cast<std::size_t>(it - first);
+        if constexpr (sizeof...(keys) == 0) {
+            return reinterpret_cast<const value_type*>(base + entriesOffset) + index;
+        } else {
+            return findNode<I + 1>(reinterpret_cast<const std::uint64_t*>(base + entriesOffset)[index], keys...);
+        }
+    }
+
+#ifdef CRAMPL_HAS_MMAP
+    std::optional<detail::MappedFile> file;
+#endif
+    const std::byte* data = nullptr;
+    std::uint64_t root = 0;
+};
+
+template<typename Map, typename... B>
+auto find_ptr(const MultiKeyMapSnapshot<Map>& snapshot, B&&... keys) {
+    return snapshot.find_ptr(keys...);
+}
+
+template<typename Map, typename... B>
+auto find_ptr(MultiKeyMapSnapshot<Map>& snapshot, B&&... keys) {
+    return snapshot.find_ptr(keys...);
+}
+
+template<typename Map, typename... B>
+auto find(const MultiKeyMapSnapshot<Map>& snapshot, B&&... keys) {
+    const auto* value = snapshot.find_ptr(keys...);
+    using Value = typename MultiKeyMapSnapshot<Map>::value_type;
+    return value ? std::optional<Value>{*value} : std::optional<Value>{};
+}
+
+template<typename Map, typename... B>
+auto find(MultiKeyMapSnapshot<Map>& snapshot, B&&... keys) {
+    return find(std::as_const(snapshot), std::forward<B>(keys)...);
+}
+
+}
@@ -0,0 +1,147 @@
+/**
+ *
+ *
+ * @file MultiKeyMapStats.h
+ * @brief Per-level occupancy and memory statistics of nested MultiKeyMaps.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iomanip>
+#include <ios>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+#include "MultiKeyMap.h"
+
+namespace crampl {
+
+// Occupancy and estimated memory of all maps on one level of a nested MultiKeyMap.
+struct LevelStats {
+    // Number of maps on this level, i.e. the number of entries of the level above (1 for the root).
+    std::size_t maps = 0;
+    // Number of entries of all maps on this level.
+    std::size_t entries = 0;
+    std::size_t minEntries = 0;
+    std::size_t maxEntries = 0;
+    // Entry count distribution: histogram[0] counts empty maps, histogram[b] maps with [2^(b-1), 2^b) entries.
+    std::vector<std::size_t> histogram;
+    // Estimated bytes allocated by the maps of this level, including the entries, and thus the inner map
+    // objects or values they contain, but not memory owned by keys and values.
+    std::size_t heapBytes = 0;
+    // Total bucket count of hash maps on this level, 0 for other map kinds.
+    std::size_t buckets = 0;
+
+    double meanEntries() const {
+        return maps ? double(entries) / double(maps) : 0.;
+    }
+
+    // Entries per bucket over all maps of this level, for hash map kinds.
+    std::optional<double> loadFactor() const {
+        return buckets ? std::optional<double>{double(entries) / double(buckets)} : std::nullopt;
+    }
+};
+
+struct MultiKeyMapStats {
+    // Size of the root map object.
+    std::size_t rootBytes = 0;
+    std::vector<LevelStats> levels;
+
+    std::size_t bytes() const {
+        std::size_t result = rootBytes;
+        for (const LevelStats& level : levels)
+            result += level.heapBytes;
+        return result;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const MultiKeyMapStats& stats) {
+        // The table is printed in fixed point; the caller's formatting is restored afterwards.
+        std::ios_base::fmtflags flags = os.flags();
+        std::streamsize precision = os.precision();
+        os << "level       maps    entries   min   mean    max  load   heap bytes\n";
+        for (std::size_t i = 0; i < stats.levels.size(); ++i) {
+            const LevelStats& level = stats.levels[i];
+            os << std::setw(5) << i << std::setw(11) << level.maps << std::setw(11) << level.entries
+               << std::setw(6) << level.minEntries << std::setw(7) << std::fixed << std::setprecision(1)
+               << level.meanEntries() << std::setw(7) << level.maxEntries << std::setw(6) << std::setprecision(2);
+            if (auto load = level.loadFactor()) {
+                os << *load;
+            } else {
+                os << '-';
+            }
+            os << std::setw(13) << level.heapBytes << '\n';
+        }
+        os << "total bytes " << stats.bytes() << '\n';
+        os.flags(flags);
+        os.precision(precision);
+        return os;
+    }
+};
+
+namespace detail {
+
+// Rounds an allocation up to the granularity of typical general purpose allocators.
+constexpr std::size_t allocationSize(std::size_t bytes) {
+    constexpr std::size_t granularity = alignof(std::max_align_t);
+    return (bytes + granularity - 1) / granularity * granularity;
+}
+
+// Bytes allocated by a single map. Maps can report this themselves through heap_bytes(); node-based
+// maps are estimated from the node layout of common standard library implementations.
+template<typename Map>
+std::size_t heapBytes(const Map& map) {
+    using Value = typename Map::value_type;
+    if constexpr (requires { map.heap_bytes(); }) {
+        return map.heap_bytes();
+    } else if constexpr (requires { map.bucket_count(); }) {
+        // Nodes hold the next pointer, the entry and possibly the cached hash, plus one pointer per bucket.
+        return map.size() * allocationSize(sizeof(void*) + sizeof(Value) + sizeof(std::size_t))
+               + map.bucket_count() * sizeof(void*);
+    } else {
+        // Tree nodes hold the color and three links next to the entry.
+        return map.size() * allocationSize(4 * sizeof(void*) + sizeof(Value));
+    }
+}
+
+template<std::size_t I, typename Map>
+void collectStats(const Map& map, std::vector<LevelStats>& levels) {
+    LevelStats& level = levels[I];
+    std::size_t size = map.size();
+    level.minEntries = level.maps ? std::min(level.minEntries, size) : size;
+    level.maxEntries = std::max(level.maxEntries, size);
+    ++level.maps;
+    level.entries += size;
+    std::size_t bucket = std::bit_width(size);
+    if (level.histogram.size() <= bucket)
+        level.histogram.resize(bucket + 1);
+    ++level.histogram[bucket];
+    level.heapBytes += heapBytes(map);
+    if constexpr (requires { map.bucket_count(); }) {
+        level.buckets += map.bucket_count();
+    }
+    if constexpr (mapDepth<Map>() > 1) {
+        for (const auto& entry : map)
+            collectStats<I + 1>(entry.second, levels);
+    }
+}
+
+}
+
+// Walks all levels of a nested MultiKeyMap and reports, per level, how many maps there are, how their entry
+// counts are distributed and roughly how much memory they allocate, e.g. to compare nested, flat and
+// hashed layouts of the same data.
+template<typename Map>
+MultiKeyMapStats stats(const Map& map) {
+    MultiKeyMapStats result;
+    result.rootBytes = sizeof(Map);
+    result.levels.resize(detail::mapDepth<const Map>());
+    detail::collectStats<0>(map, result.levels);
+    return result;
+}
+
+}
@@ -0,0 +1,210 @@
+/**
+ *
+ *
+ * @file MultiKeyMapView.h
+ * @brief Lazy flattened views over all entries of a MultiKeyMap, or the entries under a key prefix.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "MultiKeyMap.h"
+
+namespace crampl {
+
+// Inclusive bound on the keys of one ordered map level, given in map order.
+template<typename Lower, typename Upper = Lower>
+struct KeyRange {
+    Lower lower;
+    Upper upper;
+};
+
+template<typename Lower, typename Upper>
+KeyRange(Lower, Upper) -> KeyRange<Lower, Upper>;
+
+namespace detail {
+
+template<typename Root, typename Sequence>
+struct LevelIterators;
+
+template<typename Root, std::size_t... I>
+struct LevelIterators<Root, std::index_sequence<I...>> {
+    using type = std::tuple<decltype(std::declval<typename LevelType<Root, I>::type&>().begin())...>;
+};
+
+// Tuple of references to the keys held by a single map key; CompositeKeys are expanded.
+template<typename Key>
+auto expandKey(const Key& key) {
+    return std::tuple<const Key&>(key);
+}
+
+template<typename... Keys>
+auto expandKey(const CompositeKey<Keys...>& key) {
+    return std::apply([](const Keys&... keys) {
+        return std::tuple<const Keys&...>(keys...);
+    }, static_cast<const std::tuple<Keys...>&>(key));
+}
+
+// Flattened (key..., value) tuple of references for the current position of all level iterators.
+template<std::size_t Levels, typename Iterators, typename Prefix>
+auto dereferenceEntry(const Iterators& its, const Prefix& prefix) {
+    return [&]<std::size_t... P, std::size_t... I>(std::index_sequence<P...>, std::index_sequence<I...>) {
+        return std::tuple_cat(expandKey(*std::get<P>(prefix))..., expandKey(std::get<I>(its)->first)...,
+                              std::tie(std::get<Levels - 1>(its)->second));
+    }(std::make_index_sequence<std::tuple_size_v<Prefix>>{}, std::make_index_sequence<Levels>{});
+}
+
+// Iterates depth-first over all leaf entries below Root, skipping empty inner maps.
+// Prefix is a tuple of pointers to the keys of the levels above Root.
+template<typename Root, typename Prefix>
+class EntryIterator {
+    static constexpr std::size_t levels = mapDepth<Root>();
+    using Iterators = typename LevelIterators<Root, std::make_index_sequence<levels>>::type;
+    using RootIterator = std::tuple_element_t<0, Iterators>;
+
+public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    // Entries are tuples of references, so they also serve as value type.
+    using value_type = decltype(dereferenceEntry<levels>(std::declval<const Iterators&>(), std::declval<const Prefix&>()));
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+
+    EntryIterator() = default;
+    EntryIterator(RootIterator first, RootIterator last, Prefix prefix): prefix(prefix) {
+        std::get<0>(its) = first;
+        std::get<0>(ends) = last;
+        settle<0>();
+    }
+
+    reference operator*() const {
+        return dereferenceEntry<levels>(its, prefix);
+    }
+
+    EntryIterator& operator++() {
+        advance<levels - 1>();
+        return *this;
+    }
+    EntryIterator operator++(int) {
+        EntryIterator result = *this;
+        ++*this;
+        return result;
+    }
+
+    friend bool operator==(const EntryIterator& lhs, const EntryIterator& rhs) {
+        return lhs.equal<0>(rhs);
+    }
+
+private:
+    // Moves the iterators of level I and below to the next leaf entry at or after the current position of level I.
+    template<std::size_t I>
+    bool settle() {
+        auto& it = std::get<I>(its);
+        auto& end = std::get<I>(ends);
+        if constexpr (I + 1 == levels) {
+            return it != end;
+        } else {
+            for (; it != end; ++it) {
+                std::get<I + 1>(its) = it->second.begin();
+                std::get<I + 1>(ends) = it->second.end();
+                if (settle<I + 1>())
+                    return true;
+            }
+            return false;
+        }
+    }
+
+    template<std::size_t I>
+    void advance() {
+        ++std::get<I>(its);
+        if (settle<I>())
+            return;
+        if constexpr (I > 0)
+            advance<I - 1>();
+    }
+
+    // Inner iterators are only compared if all outer ones are equal and valid, i.e. point into the same map.
+    template<std::size_t I>
+    bool equal(const EntryIterator& rhs) const {
+        if (std::get<I>(its) != std::get<I>(rhs.its))
+            return false;
+        if constexpr (I + 1 == levels) {
+            return true;
+        } else {
+            return std::get<I>(its) == std::get<I>(ends) || equal<I + 1>(rhs);
+        }
+    }
+
+    Iterators its{};
+    Iterators ends{};
+    Prefix prefix{};
+};
+
+template<typename Root, typename Prefix>
+class EntriesView : public std::ranges::view_interface<EntriesView<Root, Prefix>> {
+public:
+    using iterator = EntryIterator<Root, Prefix>;
+    using RootIterator = decltype(std::declval<Root&>().begin());
+
+    EntriesView() = default;
+    EntriesView(RootIterator first, RootIterator last, Prefix prefix)
+        : first(first, last, prefix), last(last, last, prefix) {}
+
+    iterator begin() const { return first; }
+    iterator end() const { return last; }
+
+private:
+    iterator first;
+    iterator last;
+};
+
+template<typename T>
+struct IsKeyRange : std::false_type {};
+
+template<typename Lower, typename Upper>
+struct IsKeyRange<KeyRange<Lower, Upper>> : std::true_type {};
+
+template<typename A, typename Prefix, typename... B>
+auto makeEntries(A& map, Prefix prefix, B&&... keys) {
+    if constexpr (sizeof...(keys) == 0) {
+        return EntriesView<A, Prefix>(map.begin(), map.end(), prefix);
+    } else if constexpr (sizeof...(keys) == 1 && (IsKeyRange<std::remove_cvref_t<B>>::value && ...)) {
+        const auto& range = (keys, ...);
+        // An inverted range is empty; its lower bound would lie behind its upper bound.
+        if (map.key_comp()(range.upper, range.lower))
+            return EntriesView<A, Prefix>(map.end(), map.end(), prefix);
+        return EntriesView<A, Prefix>(map.lower_bound(range.lower), map.upper_bound(range.upper), prefix);
+    } else {
+        return splitArgs<keyArity<A>>([&](auto&& key, auto&&... tail) {
+            auto it = map.find(levelKey<A>(std::move(key)));
+            auto inner = [&] {
+                return makeEntries(it->second, std::tuple_cat(prefix, std::make_tuple(&it->first)), static_cast<decltype(tail)>(tail)...);
+            };
+            return it == map.end() ? decltype(inner()){} : inner();
+        }, std::forward<B>(keys)...);
+    }
+}
+
+}
+
+// Lazy view over the entries of a MultiKeyMap as flattened (key..., value) tuples of references,
+// in map order. The keys of CompositeKey levels are expanded into separate tuple elements, and values
+// can be modified through the view unless the map is const.
+// Given a key prefix, only the entries below it are visited; if the last argument is a KeyRange, it
+// further restricts the level after the prefix to the keys from lower through upper (ordered maps only).
+// Nothing is copied or allocated, and empty inner maps are skipped.
+template<typename A, typename... B>
+auto entries(A& map, B&&... prefix) {
+    return detail::makeEntries(map, std::tuple<>{}, std::forward<B>(prefix)...);
+}
+
+}
+
+template<typename Root, typename Prefix>
+inline constexpr bool std::ranges::enable_borrowed_range<crampl::detail::EntriesView<Root, Prefix>> = true;
@@ -0,0 +1,174 @@
+/**
+ *
+ *
+ * @file NormalizedKey.h
+ * @brief Order-preserving binary encoding of selected members, for radix sorting in MemberComparator order.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <crampl/MemberComparator.h>
+#include <crampl/PointerRange.h>
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace crampl {
+
+namespace detail {
+
+// Maps a value to an unsigned integer of the same size whose order agrees with std::less on the value.
+template<typename T>
+constexpr auto orderedBits(T value) noexcept
+{
+	if constexpr (std::is_enum_v<T>) {
+		return orderedBits(static_cast<std::underlying_type_t<T>>(value));
+	} else if constexpr (std::is_same_v<T, bool>) {
+		return static_cast<std::uint8_t>(value);
+	} else if constexpr (std::is_integral_v<T>) {
+		using U = std::make_unsigned_t<T>;
+		if constexpr (std::is_signed_v<T>)
+			return static_cast<U>(static_cast<U>(value) ^ (U(1) << (sizeof(T) * CHAR_BIT - 1)));
+		else
+			return static_cast<U>(value);
+	} else {
+		static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "Unsupported member type for NormalizedKey.");
+		using U = std::conditional_t<std::is_same_v<T, float>, std::uint32_t, std::uint64_t>;
+		constexpr U sign = U(1) << (sizeof(T) * CHAR_BIT - 1);
+		// -0 and +0 are equivalent according to std::less.
+		U bits = std::bit_cast<U>(value == T(0) ? T(0) : value);
+		return static_cast<U>(bits & sign ? ~bits : bits | sign);
+	}
+}
+
+// Describes how a member value is encoded into a NormalizedKey. Fixed-width values are stored as their
+// orderedBits in big-endian order. Variable-length values are byte strings whose zero bytes are escaped
+// as 0x00 0xff and that are terminated by 0x00 0x00, so that a proper prefix sorts first.
+template<typename T, typename = void>
+struct KeyEncoding {
+	static constexpr bool fixedWidth = true;
+	static constexpr std::size_t size = sizeof(orderedBits(std::declval<T>()));
+
+	static void encode(const T &value, unsigned char *out) noexcept
+	{
+		auto bits = orderedBits(value);
+		for (std::size_t i = 0; i < size; ++i)
+			out[i] = static_cast<unsigned char>(bits >> ((size - 1 - i) * CHAR_BIT));
+	}
+};
+
+inline void appendEscaped(std::string &out, unsigned char byte)
+{
+	out.push_back(static_cast<char>(byte));
+	if (byte == 0)
+		out.push_back(static_cast<char>(0xff));
+}
+
+inline void appendTerminator(std::string &out)
+{ out.append(2, '\0'); }
+
+// Strings compare their characters as unsigned char.
+template<typename T>
+struct KeyEncoding<T, std::enable_if_t<std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>>> {
+	static constexpr bool fixedWidth = false;
+
+	static void encode(std::string_view value, std::string &out)
+	{
+		for (char c : value)
+			appendEscaped(out, static_cast<unsigned char>(c));
+		appendTerminator(out);
+	}
+};
+
+// PointerRanges compare their elements lexicographically, so each element is encoded with its orderedBits.
+template<typename PointerType, typename ValueType>
+struct KeyEncoding<PointerRange<PointerType, std::less<ValueType>>> {
+	static constexpr bool fixedWidth = false;
+
+	static void encode(const PointerRange<PointerType, std::less<ValueType>> &range, std::string &out)
+	{
+		for (PointerType it = range.begin; it != range.end; ++it) {
+			unsigned char bytes[KeyEncoding<ValueType>::size];
+			KeyEncoding<ValueType>::encode(*it, bytes);
+			for (unsigned char byte : bytes)
+				appendEscaped(out, byte);
+		}
+		appendTerminator(out);
+	}
+};
+
+}
+
+// Order-preserving encoding of the members specified by M...: for any two objects, the keys compare like
+// MemberComparator<M...> compares the objects. Signed and unsigned integers, enums, bool, float and double
+// members, strings and PointerRanges of those with the default Compare are supported.
+// If all members have a fixed width of at most eight bytes in total, the key is a std::uint64_t, otherwise
+// it is a big-endian std::array of bytes or, with variable-length members, a std::string of bytes.
+template<auto... M>
+struct NormalizedKey {
+	typedef detail::ObjectType<M...> objectType;
+
+	static constexpr bool fixedWidth = (detail::KeyEncoding<typename detail::MemberWrapper<M>::valueType>::fixedWidth && ...);
+
+	static constexpr std::size_t width()
+	{
+		if constexpr (fixedWidth)
+			return (std::size_t(0) + ... + detail::KeyEncoding<typename detail::MemberWrapper<M>::valueType>::size);
+		else
+			return 0;
+	}
+
+	// Number of significant bytes of the key; for std::uint64_t keys these are its least significant bytes.
+	static constexpr std::size_t size = width();
+
+	typedef std::conditional_t<!fixedWidth, std::string,
+		std::conditional_t<(size <= sizeof(std::uint64_t)), std::uint64_t, std::array<unsigned char, size>>> type;
+
+	static type get(const objectType &object)
+	{
+		if constexpr (!fixedWidth) {
+			type key;
+			(append<M>(object, key), ...);
+			return key;
+		} else {
+			std::array<unsigned char, size> bytes;
+			unsigned char *out = bytes.data();
+			((detail::KeyEncoding<typename detail::MemberWrapper<M>::valueType>::encode(detail::MemberWrapper<M>::get(object), out),
+			  out += detail::KeyEncoding<typename detail::MemberWrapper<M>::valueType>::size), ...);
+			if constexpr (std::is_same_v<type, std::uint64_t>) {
+				std::uint64_t key = 0;
+				for (unsigned char byte : bytes)
+					key = (key << CHAR_BIT) | byte;
+				return key;
+			} else {
+				return bytes;
+			}
+		}
+	}
+
+	type operator()(const objectType &object) const
+	{ return get(object); }
+
+private:
+	template<auto m>
+	static void append(const objectType &object, std::string &key)
+	{
+		using Encoding = detail::KeyEncoding<typename detail::MemberWrapper<m>::valueType>;
+		if constexpr (Encoding::fixedWidth) {
+			unsigned char bytes[Encoding::size];
+			Encoding::encode(detail::MemberWrapper<m>::get(object), bytes);
+			key.append(reinterpret_cast<const char*>(bytes), Encoding::size);
+		} else {
+			Encoding::encode(detail::MemberWrapper<m>::get(object), key);
+		}
+	}
+};
+
+}
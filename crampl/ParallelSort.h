@@ -0,0 +1,274 @@
+/**
+ *
+ *
+ * @file ParallelSort.h
+ * @brief Parallel sort, stable sort and k-way merge with comparators such as MemberComparator, run on a WorkStealingPool.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "WorkStealingPool.h"
+
+namespace crampl {
+
+// Inputs smaller than this are sorted or merged sequentially: below it, handing work to other threads costs
+// more than it saves. Parallel runs also keep at least half of it per thread.
+inline constexpr std::size_t parallelSortThreshold = std::size_t(1) << 15;
+
+namespace detail {
+
+// Calls body(i) for all i < count on the calling thread and on up to pool.size() workers. Indices are
+// claimed from a shared counter, so the calling thread makes progress even if no worker is free, e.g. when
+// it is a worker of the pool itself. Workers that start after all indices are claimed return right away.
+// If body throws, the remaining indices are skipped and the first exception is rethrown on the calling
+// thread once no thread runs body anymore.
+template<typename Pool, typename Body>
+void parallelFor(Pool &pool, std::size_t count, const Body &body)
+{
+	struct State {
+		std::atomic<std::size_t> next = 0;
+		std::atomic<std::size_t> done = 0;
+		std::atomic<bool> failed = false;
+		std::exception_ptr exception;
+		std::size_t count;
+		const Body *body;
+
+		void work() noexcept {
+			for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+				if (!failed.load(std::memory_order_relaxed)) {
+					try {
+						(*body)(i);
+					} catch (...) {
+						// Published to the calling thread by the increment of done below.
+						if (!failed.exchange(true, std::memory_order_relaxed))
+							exception = std::current_exception();
+					}
+				}
+				if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == count)
+					done.notify_all();
+			}
+		}
+	};
+	auto state = std::make_shared<State>();
+	state->count = count;
+	state->body = &body;
+	for (std::size_t i = 1; i < std::min(count, pool.size() + 1); ++i)
+		pool.submit([state] { state->work(); });
+	state->work();
+	for (std::size_t done; (done = state->done.load(std::memory_order_acquire)) < count;)
+		state->done.wait(done, std::memory_order_acquire);
+	if (state->exception)
+		std::rethrow_exception(state->exception);
+}
+
+// Merges the sorted ranges [first, last) of cursors by repeatedly emitting the smallest head, using a binary
+// heap. Of equivalent elements, those of earlier ranges are emitted first.
+template<typename It, typename Compare, typename Emit>
+void kwayMerge(std::vector<std::pair<It, It>> ranges, Compare &comp, Emit emit)
+{
+	std::erase_if(ranges, [](const auto &range) { return range.first == range.second; });
+	if (ranges.size() == 1) {
+		for (It it = ranges[0].first; it != ranges[0].second; ++it)
+			emit(it);
+		return;
+	}
+	// The heap holds indices into ranges; later is greater, so that the heap yields the element of the
+	// earliest range among equivalent ones.
+	auto later = [&](std::size_t lhs, std::size_t rhs) {
+		if (comp(*ranges[rhs].first, *ranges[lhs].first)) return true;
+		if (comp(*ranges[lhs].first, *ranges[rhs].first)) return false;
+		return lhs > rhs;
+	};
+	std::vector<std::size_t> heap(ranges.size());
+	for (std::size_t i = 0; i < heap.size(); ++i)
+		heap[i] = i;
+	std::make_heap(heap.begin(), heap.end(), later);
+	while (heap.size() > 1) {
+		std::pop_heap(heap.begin(), heap.end(), later);
+		auto &range = ranges[heap.back()];
+		emit(range.first);
+		if (++range.first == range.second)
+			heap.pop_back();
+		else
+			std::push_heap(heap.begin(), heap.end(), later);
+	}
+	if (!heap.empty())
+		for (It it = ranges[heap[0]].first; it != ranges[heap[0]].second; ++it)
+			emit(it);
+}
+
+// Merges sorted ranges into the output starting at out in up to pool.size() + 1 parts. Part boundaries are
+// the lower bounds of splitters taken from the largest range, so all elements equivalent to a splitter end up
+// in the same part. makeEmit(part, outputIndex) returns the emit function for the part starting at that
+// output position.
+template<typename It, typename Compare, typename Pool, typename MakeEmit>
+void parallelKwayMerge(const std::vector<std::pair<It, It>> &ranges, Compare comp, Pool &pool, std::size_t total, MakeEmit makeEmit)
+{
+	std::size_t parts = std::clamp<std::size_t>(total / (parallelSortThreshold / 2), 1, pool.size() + 1);
+	if (parts == 1 || ranges.size() < 2) {
+		kwayMerge(ranges, comp, makeEmit(0, 0));
+		return;
+	}
+	const auto &largest = *std::ranges::max_element(ranges, {}, [](const auto &range) { return range.second - range.first; });
+	std::size_t largestSize = static_cast<std::size_t>(largest.second - largest.first);
+	// bounds[j][r] is where part j starts in range r.
+	std::vector<std::vector<It>> bounds(parts + 1);
+	bounds[0].reserve(ranges.size());
+	bounds[parts].reserve(ranges.size());
+	for (const auto &range : ranges) {
+		bounds[0].push_back(range.first);
+		bounds[parts].push_back(range.second);
+	}
+	for (std::size_t j = 1; j < parts; ++j) {
+		const auto &splitter = *(largest.first + largestSize * j / parts);
+		bounds[j].reserve(ranges.size());
+		for (std::size_t r = 0; r < ranges.size(); ++r)
+			bounds[j].push_back(std::lower_bound(bounds[j - 1][r], ranges[r].second, splitter, comp));
+	}
+	parallelFor(pool, parts, [&](std::size_t j) {
+		std::vector<std::pair<It, It>> part;
+		part.reserve(ranges.size());
+		std::size_t offset = 0;
+		for (std::size_t r = 0; r < ranges.size(); ++r) {
+			part.emplace_back(bounds[j][r], bounds[j + 1][r]);
+			offset += static_cast<std::size_t>(bounds[j][r] - ranges[r].first);
+		}
+		Compare partComp = comp;
+		kwayMerge(std::move(part), partComp, makeEmit(j, offset));
+	});
+}
+
+// Sorts chunks of [first, last) in parallel and merges them into a temporary buffer, from which the
+// elements are moved back in parallel.
+template<bool Stable, typename It, typename Compare, typename Pool>
+void parallelMergeSort(It first, It last, Compare comp, Pool &pool)
+{
+	using T = std::iter_value_t<It>;
+	std::size_t n = static_cast<std::size_t>(last - first);
+	std::size_t chunks = std::min<std::size_t>(n / (parallelSortThreshold / 2), pool.size() + 1);
+	if (n < parallelSortThreshold || chunks < 2) {
+		if constexpr (Stable)
+			std::stable_sort(first, last, comp);
+		else
+			std::sort(first, last, comp);
+		return;
+	}
+
+	std::vector<std::pair<It, It>> ranges(chunks);
+	for (std::size_t i = 0; i < chunks; ++i)
+		ranges[i] = {first + n * i / chunks, first + n * (i + 1) / chunks};
+	parallelFor(pool, chunks, [&](std::size_t i) {
+		if constexpr (Stable)
+			std::stable_sort(ranges[i].first, ranges[i].second, comp);
+		else
+			std::sort(ranges[i].first, ranges[i].second, comp);
+	});
+
+	std::allocator<T> allocator;
+	T *buffer = allocator.allocate(n);
+	// merged[j] is the part of the buffer that part j of the merge has constructed so far, which has to be
+	// destroyed again if the merge throws.
+	std::vector<std::pair<T *, T *>> merged(pool.size() + 1);
+	try {
+		parallelKwayMerge(ranges, comp, pool, n, [buffer, &merged](std::size_t part, std::size_t offset) {
+			merged[part] = {buffer + offset, buffer + offset};
+			return [&end = merged[part].second](It it) {
+				std::construct_at(end, std::move(*it));
+				++end;
+			};
+		});
+		parallelFor(pool, chunks, [&](std::size_t i) {
+			std::move(buffer + n * i / chunks, buffer + n * (i + 1) / chunks, first + n * i / chunks);
+		});
+	} catch (...) {
+		for (auto [begin, end] : merged)
+			std::destroy(begin, end);
+		allocator.deallocate(buffer, n);
+		throw;
+	}
+	parallelFor(pool, chunks, [&](std::size_t i) {
+		std::destroy(buffer + n * i / chunks, buffer + n * (i + 1) / chunks);
+	});
+	allocator.deallocate(buffer, n);
+}
+
+// Pool used by the overloads without a pool argument. The calling thread takes part in the work, so it
+// has one worker less than there are hardware threads.
+inline WorkStealingPool<> &sortPool()
+{
+	static WorkStealingPool<> pool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+	return pool;
+}
+
+}
+
+// Sorts [first, last) according to comp, e.g. a MemberComparator, using the calling thread and the workers
+// of pool. Inputs below parallelSortThreshold are sorted with std::sort.
+template<std::random_access_iterator It, typename Compare, typename Pool>
+void parallel_sort(It first, It last, Compare comp, Pool &pool)
+{ detail::parallelMergeSort<false>(first, last, std::move(comp), pool); }
+
+template<std::random_access_iterator It, typename Compare>
+void parallel_sort(It first, It last, Compare comp)
+{ parallel_sort(first, last, std::move(comp), detail::sortPool()); }
+
+// Like parallel_sort, but keeps the order of equivalent elements.
+template<std::random_access_iterator It, typename Compare, typename Pool>
+void parallel_stable_sort(It first, It last, Compare comp, Pool &pool)
+{ detail::parallelMergeSort<true>(first, last, std::move(comp), pool); }
+
+template<std::random_access_iterator It, typename Compare>
+void parallel_stable_sort(It first, It last, Compare comp)
+{ parallel_stable_sort(first, last, std::move(comp), detail::sortPool()); }
+
+// Merges a range of ranges sorted according to comp into out and returns the end of the output. Equivalent
+// elements are ordered by the range they come from.
+template<std::ranges::input_range Ranges, typename OutputIt, typename Compare>
+	requires std::ranges::forward_range<std::ranges::range_reference_t<Ranges>>
+OutputIt kway_merge(Ranges &&ranges, OutputIt out, Compare comp)
+{
+	using It = std::ranges::iterator_t<std::ranges::range_reference_t<Ranges>>;
+	std::vector<std::pair<It, It>> cursors;
+	for (auto &&range : ranges)
+		cursors.emplace_back(std::ranges::begin(range), std::ranges::end(range));
+	detail::kwayMerge(std::move(cursors), comp, [&out](It it) { *out++ = *it; });
+	return out;
+}
+
+// Like kway_merge, but splits the output into independent parts that are merged by the calling thread and
+// the workers of pool. Inputs below parallelSortThreshold in total are merged sequentially.
+template<std::ranges::input_range Ranges, std::random_access_iterator OutputIt, typename Compare, typename Pool>
+	requires std::ranges::random_access_range<std::ranges::range_reference_t<Ranges>>
+OutputIt parallel_kway_merge(Ranges &&ranges, OutputIt out, Compare comp, Pool &pool)
+{
+	using It = std::ranges::iterator_t<std::ranges::range_reference_t<Ranges>>;
+	std::vector<std::pair<It, It>> cursors;
+	std::size_t total = 0;
+	for (auto &&range : ranges) {
+		cursors.emplace_back(std::ranges::begin(range), std::ranges::end(range));
+		total += static_cast<std::size_t>(std::ranges::size(range));
+	}
+	detail::parallelKwayMerge(cursors, std::move(comp), pool, total, [out](std::size_t, std::size_t offset) {
+		return [it = out + offset](It source) mutable { *it++ = *source; };
+	});
+	return out + total;
+}
+
+template<std::ranges::input_range Ranges, std::random_access_iterator OutputIt, typename Compare>
+	requires std::ranges::random_access_range<std::ranges::range_reference_t<Ranges>>
+OutputIt parallel_kway_merge(Ranges &&ranges, OutputIt out, Compare comp)
+{ return parallel_kway_merge(std::forward<Ranges>(ranges), out, std::move(comp), detail::sortPool()); }
+
+}
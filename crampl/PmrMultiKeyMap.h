@@ -0,0 +1,34 @@
+/**
+ *
+ *
+ * @file PmrMultiKeyMap.h
+ * @brief MultiKeyMaps whose levels all allocate from one std::pmr::memory_resource.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <map>
+#include <memory_resource>
+#include <unordered_map>
+
+#include "MultiKeyMap.h"
+
+namespace crampl::pmr {
+
+// MultiKeyMaps built from the std::pmr map kinds. Their polymorphic allocators perform uses-allocator
+// construction, so every inner map (and every allocator-aware key or value) that crampl::emplace or
+// crampl::bulk_load creates uses the memory resource of the outermost map, e.g. a
+// std::pmr::monotonic_buffer_resource that releases the whole index at once.
+template<typename... KeyTypes_AND_ValueType>
+using MultiKeyMap = crampl::MultiKeyMap<std::pmr::map, KeyTypes_AND_ValueType...>;
+
+template<typename... KeyTypes_AND_ValueType>
+using UnorderedMultiKeyMap = crampl::MultiKeyMap<std::pmr::unordered_map, KeyTypes_AND_ValueType...>;
+
+template<typename... KeyTypes_AND_ValueType>
+using FlatMultiKeyMap = crampl::FlatMultiKeyMap<std::pmr::map, KeyTypes_AND_ValueType...>;
+
+template<typename... KeyTypes_AND_ValueType>
+using UnorderedFlatMultiKeyMap = crampl::FlatMultiKeyMap<std::pmr::unordered_map, KeyTypes_AND_ValueType...>;
+
+}
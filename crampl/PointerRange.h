@@ -9,6 +9,7 @@
 #pragma once
 
 #include <algorithm>
+#include <compare>
 #include <functional>
 
 namespace crampl {
@@ -24,6 +25,23 @@ struct PointerRange {
         Compare cmp;
         return std::lexicographical_compare(begin, end, rhs.begin, rhs.end, cmp);
     }
+    // Compares the ranges in a single pass. Uses operator<=> of the elements for the default Compare and
+    // otherwise derives a weak ordering from Compare.
+    auto operator<=>(const PointerRange &rhs) const {
+        using ValueType = std::decay_t<decltype(*std::declval<PointerType>())>;
+        if constexpr (std::is_same_v<Compare, std::less<ValueType>> && requires(const ValueType& v) { v <=> v; }) {
+            return std::lexicographical_compare_three_way(begin, end, rhs.begin, rhs.end);
+        } else {
+            Compare cmp;
+            PointerType l = begin, r = rhs.begin;
+            for (; l != end && r != rhs.end; ++l, ++r) {
+                if (cmp(*l, *r)) return std::weak_ordering::less;
+                if (cmp(*r, *l)) return std::weak_ordering::greater;
+            }
+            if (l != end) return std::weak_ordering::greater;
+            return r != rhs.end ? std::weak_ordering::less : std::weak_ordering::equivalent;
+        }
+    }
 };
 
 template<typename PointerType, typename SizeType>
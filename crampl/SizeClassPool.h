@@ -0,0 +1,113 @@
+/**
+ *
+ *
+ * @file SizeClassPool.h
+ * @brief Unsynchronized size-class pool resource for small, short-lived objects such as the states of crampl::Functions.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+namespace crampl::pmr {
+
+// Memory resource that serves blocks of up to maxBlockSize bytes from power-of-two size classes. Each class
+// keeps a free list that is refilled by carving chunks obtained from the upstream resource, so allocating and
+// freeing are a handful of instructions and never touch the global allocator once the pool is warm. Larger
+// or over-aligned requests go to the upstream resource. Chunks are only returned on release() or destruction.
+// Not thread-safe: use one pool per thread, e.g. thread_pool(), and free blocks on the thread that allocated them.
+class SizeClassPool : public std::pmr::memory_resource {
+public:
+	static constexpr std::size_t minBlockSize = 16;
+	static constexpr std::size_t maxBlockSize = 1024;
+
+	explicit SizeClassPool(std::pmr::memory_resource* upstream = std::pmr::get_default_resource(), std::size_t chunkSize = 64 * 1024)
+		: upstream(upstream), chunkSize(std::max(chunkSize, 2 * maxBlockSize)) {}
+	SizeClassPool(const SizeClassPool&) = delete;
+	SizeClassPool& operator=(const SizeClassPool&) = delete;
+	~SizeClassPool() override {
+		release();
+	}
+
+	// Returns all chunks to the upstream resource, invalidating all blocks handed out so far.
+	void release() {
+		while (chunks) {
+			Chunk* next = chunks->next;
+			upstream->deallocate(chunks, chunks->size, alignof(std::max_align_t));
+			chunks = next;
+		}
+		freeLists.fill(nullptr);
+	}
+
+	std::pmr::memory_resource* upstream_resource() const noexcept {
+		return upstream;
+	}
+
+protected:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+		if (bytes > maxBlockSize || alignment > alignof(std::max_align_t))
+			return upstream->allocate(bytes, alignment);
+		std::size_t index = sizeClass(bytes);
+		if (!freeLists[index])
+			refill(index);
+		FreeBlock* block = freeLists[index];
+		freeLists[index] = block->next;
+		return block;
+	}
+
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+		if (bytes > maxBlockSize || alignment > alignof(std::max_align_t)) {
+			upstream->deallocate(p, bytes, alignment);
+			return;
+		}
+		std::size_t index = sizeClass(bytes);
+		freeLists[index] = new (p) FreeBlock{freeLists[index]};
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+private:
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+	struct alignas(std::max_align_t) Chunk {
+		Chunk* next;
+		std::size_t size;
+	};
+
+	static constexpr std::size_t classCount = std::bit_width(maxBlockSize / minBlockSize);
+
+	static std::size_t sizeClass(std::size_t bytes) {
+		return std::bit_width((std::max(bytes, minBlockSize) - 1) / minBlockSize);
+	}
+
+	// Splits a new chunk into blocks of one size class.
+	void refill(std::size_t index) {
+		std::size_t blockSize = minBlockSize << index;
+		chunks = new (upstream->allocate(chunkSize, alignof(std::max_align_t))) Chunk{chunks, chunkSize};
+		std::byte* first = reinterpret_cast<std::byte*>(chunks) + sizeof(Chunk);
+		std::size_t count = (chunkSize - sizeof(Chunk)) / blockSize;
+		for (std::size_t i = count; i > 0; --i)
+			freeLists[index] = new (first + (i - 1) * blockSize) FreeBlock{freeLists[index]};
+	}
+
+	std::pmr::memory_resource* upstream;
+	std::size_t chunkSize;
+	Chunk* chunks = nullptr;
+	std::array<FreeBlock*, classCount> freeLists {};
+};
+
+// Pool of the calling thread, e.g. for the states of Functions that are created and destroyed on one thread.
+inline SizeClassPool& thread_pool() {
+	thread_local SizeClassPool pool;
+	return pool;
+}
+
+}
@@ -0,0 +1,294 @@
+/**
+ *
+ *
+ * @file SortedVectorMap.h
+ * @brief Map stored as a sorted contiguous array, usable as MapKind of read-mostly MultiKeyMaps.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace crampl {
+
+// Map that keeps its entries sorted by key in one contiguous array, for indexes that are built once and
+// then mostly read. Lookups are branchless binary searches over cache-dense memory. Single insertions
+// and erasures shift the tail of the array, so they are linear; appending in key order through
+// emplace_hint(end(), ...) is constant, which is what crampl::bulk_load does, and insert(first, last) adds
+// a whole batch with a single sort. The interface follows std::map closely enough to serve as MapKind of a
+// MultiKeyMap, with the key comparator as third template parameter (as for ComplexKey).
+// Unlike std::map, value_type is std::pair<Key, Value> and insertions invalidate references and iterators.
+template<typename Key, typename Value, typename Compare = std::less<Key>, typename Allocator = std::allocator<std::pair<Key, Value>>>
+class SortedVectorMap {
+    using Storage = std::vector<std::pair<Key, Value>, Allocator>;
+    static constexpr bool transparent = requires { typename Compare::is_transparent; };
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = typename Storage::iterator;
+    using const_iterator = typename Storage::const_iterator;
+
+    struct value_compare {
+        bool operator()(const value_type& lhs, const value_type& rhs) const {
+            return comp(lhs.first, rhs.first);
+        }
+        [[no_unique_address]] Compare comp;
+    };
+
+    SortedVectorMap() = default;
+    explicit SortedVectorMap(const Compare& comp, const Allocator& alloc = Allocator()): entries(alloc), comp(comp) {}
+    explicit SortedVectorMap(const Allocator& alloc): entries(alloc) {}
+    template<std::input_iterator It>
+    SortedVectorMap(It first, It last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : entries(alloc), comp(comp) {
+        insert(first, last);
+    }
+    SortedVectorMap(std::initializer_list<value_type> values, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : SortedVectorMap(values.begin(), values.end(), comp, alloc) {}
+    SortedVectorMap(const SortedVectorMap&) = default;
+    SortedVectorMap(const SortedVectorMap& other, const Allocator& alloc): entries(other.entries, alloc), comp(other.comp) {}
+    SortedVectorMap(SortedVectorMap&&) noexcept = default;
+    SortedVectorMap(SortedVectorMap&& other, const Allocator& alloc): entries(std::move(other.entries), alloc), comp(std::move(other.comp)) {}
+
+    SortedVectorMap& operator=(const SortedVectorMap&) = default;
+    SortedVectorMap& operator=(SortedVectorMap&&) = default;
+
+    allocator_type get_allocator() const noexcept { return entries.get_allocator(); }
+    key_compare key_comp() const { return comp; }
+    value_compare value_comp() const { return {comp}; }
+
+    iterator begin() noexcept { return entries.begin(); }
+    const_iterator begin() const noexcept { return entries.begin(); }
+    const_iterator cbegin() const noexcept { return entries.cbegin(); }
+    iterator end() noexcept { return entries.end(); }
+    const_iterator end() const noexcept { return entries.end(); }
+    const_iterator cend() const noexcept { return entries.cend(); }
+
+    bool empty() const noexcept { return entries.empty(); }
+    size_type size() const noexcept { return entries.size(); }
+    size_type max_size() const noexcept { return entries.max_size(); }
+    size_type capacity() const noexcept { return entries.capacity(); }
+    // Bytes allocated for the entries, as reported by MultiKeyMap stats.
+    std::size_t heap_bytes() const noexcept { return entries.capacity() * sizeof(value_type); }
+    void reserve(size_type count) { entries.reserve(count); }
+    void shrink_to_fit() { entries.shrink_to_fit(); }
+    void clear() noexcept { entries.clear(); }
+
+    template<typename K> requires (transparent || std::is_same_v<K, Key>)
+    iterator lower_bound(const K& key) { return begin() + lowerBoundIndex(key); }
+    template<typename K> requires (transparent || std::is_same_v<K, Key>)
+    const_iterator lower_bound(const K& key) const { return begin() + lowerBoundIndex(key); }
+    iterator lower_bound(const Key& key) { return lower_bound<Key>(key); }
+    const_iterator lower_bound(const Key& key) const { return lower_bound<Key>(key); }
+
+    template<typename K> requires (transparent || std::is_same_v<K, Key>)
+    iterator upper_bound(const K& key) { return begin() + upperBoundIndex(key); }
+    template<typename K> requires (transparent || std::is_same_v<K, Key>)
+    const_iterator upper_bound(const K& key) const { return begin() + upperBoundIndex(key); }
+    iterator upper_bound(const Key& key) { return upper_bound<Key>(key); }
+    const_iterator upper_bound(const Key& key) const { return upper_bound<Key>(key); }
+
+    template<typename K> requires (transparent || std::is_same_v<K, Key>)
+    iterator find(const K& key) { return begin() + findIndex(key); }
+    template<typename K> requires (transparent || std::is_same_v<K, Key>)
+    const_iterator find(const K& key) const { return begin() + findIndex(key); }
+    iterator find(const Key& key) { return find<Key>(key); }
+    const_iterator find(const Key& key) const { return find<Key>(key); }
+
+    template<typename K> requires (transparent || std::is_same_v<K, Key>)
+    std::pair<iterator, iterator> equal_range(const K& key) {
+        iterator it = find(key);
+        return {it, it == end() ? it : std::next(it)};
+    }
+    std::pair<iterator, iterator> equal_range(const Key& key) { return equal_range<Key>(key); }
+
+    template<typename K> requires (transparent || std::is_same_v<K, Key>)
+    bool contains(const K& key) const { return findIndex(key) != size(); }
+    bool contains(const Key& key) const { return findIndex(key) != size(); }
+    template<typename K> requires (transparent || std::is_same_v<K, Key>)
+    size_type count(const K& key) const { return contains(key); }
+    size_type count(const Key& key) const { return contains(key); }
+
+    Value& at(const Key& key) {
+        iterator it = find(key);
+        if (it == end())
+            throw std::out_of_range("crampl::SortedVectorMap::at");
+        return it->second;
+    }
+    const Value& at(const Key& key) const {
+        return const_cast<SortedVectorMap&>(*this).at(key);
+    }
+    Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+    Value& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
+
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        if constexpr (!transparent && !std::is_same_v<std::remove_cvref_t<K>, Key>) {
+            return try_emplace(makeKey(std::forward<K>(key)), std::forward<Args>(args)...);
+        } else {
+            return emplaceAt(lower_bound(key), std::forward<K>(key), std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+    }
+
+    template<typename KeyArgs, typename ValueArgs>
+    std::pair<iterator, bool> emplace(std::piecewise_construct_t, KeyArgs&& keyArgs, ValueArgs&& valueArgs) {
+        return emplaceHinted(end(), makeKeyFromTuple(std::forward<KeyArgs>(keyArgs)), std::forward<ValueArgs>(valueArgs), false);
+    }
+    template<typename K, typename V>
+    std::pair<iterator, bool> emplace(K&& key, V&& value) {
+        return emplaceHinted(end(), makeKey(std::forward<K>(key)), std::forward_as_tuple(std::forward<V>(value)), false);
+    }
+    template<typename P>
+    std::pair<iterator, bool> emplace(P&& value) {
+        return emplace(std::get<0>(std::forward<P>(value)), std::get<1>(std::forward<P>(value)));
+    }
+
+    // A hint of end() for a key that is greater than all stored keys appends in constant time.
+    template<typename KeyArgs, typename ValueArgs>
+    iterator emplace_hint(const_iterator hint, std::piecewise_construct_t, KeyArgs&& keyArgs, ValueArgs&& valueArgs) {
+        return emplaceHinted(hint, makeKeyFromTuple(std::forward<KeyArgs>(keyArgs)), std::forward<ValueArgs>(valueArgs), true).first;
+    }
+    template<typename K, typename V>
+    iterator emplace_hint(const_iterator hint, K&& key, V&& value) {
+        return emplaceHinted(hint, makeKey(std::forward<K>(key)), std::forward_as_tuple(std::forward<V>(value)), true).first;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) { return emplace(value); }
+    std::pair<iterator, bool> insert(value_type&& value) { return emplace(std::move(value)); }
+
+    // Inserts a batch of entries: appends them, sorts only the new ones and merges them in. Of several
+    // entries with equal keys the one inserted first is kept, as with repeated emplace.
+    template<std::input_iterator It>
+    void insert(It first, It last) {
+        size_type oldSize = size();
+        for (; first != last; ++first)
+            entries.emplace_back(*first);
+        auto middle = entries.begin() + static_cast<difference_type>(oldSize);
+        std::stable_sort(middle, entries.end(), value_comp());
+        std::inplace_merge(entries.begin(), middle, entries.end(), value_comp());
+        entries.erase(std::unique(entries.begin(), entries.end(), [&](const value_type& lhs, const value_type& rhs) {
+            return !comp(lhs.first, rhs.first);
+        }), entries.end());
+    }
+    void insert(std::initializer_list<value_type> values) { insert(values.begin(), values.end()); }
+
+    iterator erase(const_iterator pos) { return entries.erase(pos); }
+    iterator erase(iterator pos) { return entries.erase(pos); }
+    iterator erase(const_iterator first, const_iterator last) { return entries.erase(first, last); }
+    template<typename K> requires (transparent || std::is_same_v<K, Key>)
+    size_type erase(const K& key) {
+        iterator it = find(key);
+        if (it == end())
+            return 0;
+        entries.erase(it);
+        return 1;
+    }
+    size_type erase(const Key& key) { return erase<Key>(key); }
+
+    void swap(SortedVectorMap& other) noexcept {
+        using std::swap;
+        swap(entries, other.entries);
+        swap(comp, other.comp);
+    }
+    friend void swap(SortedVectorMap& lhs, SortedVectorMap& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    friend bool operator==(const SortedVectorMap& lhs, const SortedVectorMap& rhs) {
+        return lhs.entries == rhs.entries;
+    }
+
+private:
+    // Branchless binary search: the loop body compiles to a conditional move instead of a jump.
+    template<typename K>
+    size_type lowerBoundIndex(const K& key) const {
+        const value_type* base = entries.data();
+        size_type length = entries.size();
+        if (length == 0)
+            return 0;
+        while (length > 1) {
+            size_type half = length / 2;
+            base = comp(base[half - 1].first, key) ? base + half : base;
+            length -= half;
+        }
+        return static_cast<size_type>(base - entries.data()) + comp(base->first, key);
+    }
+
+    template<typename K>
+    size_type upperBoundIndex(const K& key) const {
+        const value_type* base = entries.data();
+        size_type length = entries.size();
+        if (length == 0)
+            return 0;
+        while (length > 1) {
+            size_type half = length / 2;
+            base = comp(key, base[half - 1].first) ? base : base + half;
+            length -= half;
+        }
+        return static_cast<size_type>(base - entries.data()) + !comp(key, base->first);
+    }
+
+    template<typename K>
+    size_type findIndex(const K& key) const {
+        size_type index = lowerBoundIndex(key);
+        return index != size() && !comp(key, entries[index].first) ? index : size();
+    }
+
+    // Temporary keys allocate like the stored ones, so that they can be moved into the array.
+    template<typename... Args>
+    Key makeKey(Args&&... args) const {
+        return std::make_obj_using_allocator<Key>(entries.get_allocator(), std::forward<Args>(args)...);
+    }
+    template<typename KeyArgs>
+    Key makeKeyFromTuple(KeyArgs&& keyArgs) const {
+        return std::apply([&](auto&&... args) { return makeKey(static_cast<decltype(args)>(args)...); },
+                          std::forward<KeyArgs>(keyArgs));
+    }
+
+    template<typename K, typename ValueArgs>
+    std::pair<iterator, bool> emplaceAt(iterator pos, K&& key, ValueArgs&& valueArgs) {
+        if (pos != end() && !comp(key, pos->first))
+            return {pos, false};
+        return {entries.emplace(pos, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward<ValueArgs>(valueArgs)), true};
+    }
+
+    template<typename ValueArgs>
+    std::pair<iterator, bool> emplaceHinted(const_iterator hint, Key&& key, ValueArgs&& valueArgs, bool useHint) {
+        if (useHint && hint == cend() && (empty() || comp(entries.back().first, key))) {
+            entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward<ValueArgs>(valueArgs));
+            return {std::prev(end()), true};
+        }
+        return emplaceAt(lower_bound(key), std::move(key), std::forward<ValueArgs>(valueArgs));
+    }
+
+    Storage entries;
+    [[no_unique_address]] Compare comp;
+};
+
+namespace pmr {
+
+template<typename Key, typename Value, typename Compare = std::less<Key>>
+using SortedVectorMap = crampl::SortedVectorMap<Key, Value, Compare, std::pmr::polymorphic_allocator<std::pair<Key, Value>>>;
+
+}
+
+}
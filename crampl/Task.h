@@ -0,0 +1,462 @@
+/**
+ *
+ *
+ * @file Task.h
+ * @brief Lazily started coroutine task whose frames are recycled instead of freed, with resumption on executors.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "Function.h"
+
+namespace crampl {
+
+// Per-thread cache of coroutine frames in power-of-two size classes. A frame freed on any thread is kept in
+// that thread's cache and handed out again to the next coroutine of its size class started there, so a
+// steady stream of Tasks stops touching the global allocator once the caches are warm. Frames can freely
+// migrate between threads, as they are only ever obtained from and returned to the global allocator.
+// Frames larger than maxFrameSize and frames beyond maxCachedFrames per class bypass the cache.
+class TaskFramePool {
+public:
+	static constexpr std::size_t minFrameSize = 64;
+	static constexpr std::size_t maxFrameSize = 4096;
+	static constexpr std::size_t maxCachedFrames = 256;
+
+	static void* allocate(std::size_t bytes) {
+		if (bytes > maxFrameSize)
+			return ::operator new(bytes);
+		std::size_t index = sizeClass(bytes);
+		FreeList& list = cache().lists[index];
+		if (!list.head)
+			return ::operator new(minFrameSize << index);
+		FreeFrame* frame = list.head;
+		list.head = frame->next;
+		--list.count;
+		return frame;
+	}
+
+	static void deallocate(void* p, std::size_t bytes) noexcept {
+		if (bytes > maxFrameSize) {
+			::operator delete(p, bytes);
+			return;
+		}
+		std::size_t index = sizeClass(bytes);
+		Cache& local = cache();
+		FreeList& list = local.lists[index];
+		if (local.destroyed || list.count == maxCachedFrames) {
+			::operator delete(p, minFrameSize << index);
+			return;
+		}
+		list.head = new (p) FreeFrame{list.head};
+		++list.count;
+	}
+
+	// Number of frames cached by the calling thread.
+	static std::size_t cached_frames() noexcept {
+		std::size_t count = 0;
+		for (const FreeList& list : cache().lists)
+			count += list.count;
+		return count;
+	}
+
+	// Returns the frames cached by the calling thread to the global allocator.
+	static void release() noexcept {
+		cache().release();
+	}
+
+private:
+	struct FreeFrame {
+		FreeFrame* next;
+	};
+	struct FreeList {
+		FreeFrame* head = nullptr;
+		std::size_t count = 0;
+	};
+
+	static constexpr std::size_t classCount = std::bit_width(maxFrameSize / minFrameSize);
+
+	struct Cache {
+		std::array<FreeList, classCount> lists {};
+		bool destroyed = false;
+
+		~Cache() {
+			release();
+			destroyed = true;
+		}
+
+		void release() noexcept {
+			for (std::size_t index = 0; index < classCount; ++index) {
+				while (FreeFrame* frame = lists[index].head) {
+					lists[index].head = frame->next;
+					::operator delete(frame, minFrameSize << index);
+				}
+				lists[index].count = 0;
+			}
+		}
+	};
+
+	static std::size_t sizeClass(std::size_t bytes) noexcept {
+		return std::bit_width((std::max(bytes, minFrameSize) - 1) / minFrameSize);
+	}
+
+	static Cache& cache() noexcept {
+		thread_local Cache local;
+		return local;
+	}
+};
+
+template<typename T = void>
+class Task;
+
+namespace detail {
+
+class TaskPromiseBase {
+	struct FinalAwaiter {
+		bool await_ready() noexcept {
+			return false;
+		}
+
+		// Symmetric transfer: the awaiting coroutine is resumed by returning it rather than by calling
+		// resume(), so a chain of tasks that complete synchronously does not grow the stack.
+		template<typename Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> coroutine) noexcept {
+			return coroutine.promise().continuation;
+		}
+
+		void await_resume() noexcept {}
+	};
+
+public:
+	static void* operator new(std::size_t bytes) {
+		return TaskFramePool::allocate(bytes);
+	}
+
+	static void operator delete(void* p, std::size_t bytes) noexcept {
+		TaskFramePool::deallocate(p, bytes);
+	}
+
+	std::suspend_always initial_suspend() noexcept {
+		return {};
+	}
+
+	FinalAwaiter final_suspend() noexcept {
+		return {};
+	}
+
+	void unhandled_exception() noexcept {
+		exception = std::current_exception();
+	}
+
+	std::coroutine_handle<> continuation = std::noop_coroutine();
+
+protected:
+	void rethrow() const {
+		if (exception)
+			std::rethrow_exception(exception);
+	}
+
+	std::exception_ptr exception;
+};
+
+template<typename T>
+class TaskPromise : public TaskPromiseBase {
+public:
+	Task<T> get_return_object() noexcept;
+
+	template<typename U = T>
+	void return_value(U&& value) requires std::is_constructible_v<T, U&&> {
+		result.emplace(std::forward<U>(value));
+	}
+
+	T take() {
+		rethrow();
+		return std::move(*result);
+	}
+
+private:
+	std::optional<T> result;
+};
+
+template<typename T>
+class TaskPromise<T&> : public TaskPromiseBase {
+public:
+	Task<T&> get_return_object() noexcept;
+
+	void return_value(T& value) noexcept {
+		result = &value;
+	}
+
+	T& take() {
+		rethrow();
+		return *result;
+	}
+
+private:
+	T* result = nullptr;
+};
+
+template<>
+class TaskPromise<void> : public TaskPromiseBase {
+public:
+	Task<void> get_return_object() noexcept;
+
+	void return_void() noexcept {}
+
+	void take() {
+		rethrow();
+	}
+};
+
+// Resumes a coroutine when called. A coroutine handle is a single pointer, so this fits into the inline
+// buffer of every Function and scheduling a resumption does not allocate.
+struct Resume {
+	std::coroutine_handle<> coroutine;
+
+	void operator()() const {
+		coroutine.resume();
+	}
+};
+
+static_assert(sizeof(Resume) <= sizeof(void*) && is_trivially_relocatable_v<Resume>);
+
+}
+
+// Coroutine that starts when it is first awaited and resumes its awaiter when it completes. The value or
+// exception the coroutine returns is handed to the awaiter. Frames come from the TaskFramePool.
+template<typename T>
+class [[nodiscard]] Task {
+public:
+	using promise_type = detail::TaskPromise<T>;
+	using value_type = T;
+
+	Task() noexcept = default;
+	Task(Task&& other) noexcept
+		: coroutine(std::exchange(other.coroutine, {})) {}
+	Task& operator=(Task&& other) noexcept {
+		if (this != &other) {
+			reset();
+			coroutine = std::exchange(other.coroutine, {});
+		}
+		return *this;
+	}
+	~Task() {
+		reset();
+	}
+
+	bool valid() const noexcept {
+		return bool(coroutine);
+	}
+
+	bool done() const noexcept {
+		return coroutine && coroutine.done();
+	}
+
+	// Awaiting requires a valid Task, i.e. one that was returned by a coroutine and not moved from.
+	bool await_ready() const noexcept {
+		assert(coroutine && "Awaiting an invalid crampl::Task.");
+		return coroutine.done();
+	}
+
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept {
+		coroutine.promise().continuation = awaiter;
+		return coroutine;
+	}
+
+	T await_resume() {
+		return coroutine.promise().take();
+	}
+
+private:
+	friend promise_type;
+
+	explicit Task(std::coroutine_handle<promise_type> coroutine) noexcept
+		: coroutine(coroutine) {}
+
+	void reset() noexcept {
+		if (coroutine)
+			std::exchange(coroutine, {}).destroy();
+	}
+
+	std::coroutine_handle<promise_type> coroutine;
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+	return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+template<typename T>
+Task<T&> TaskPromise<T&>::get_return_object() noexcept {
+	return Task<T&>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+	return Task<void>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+template<typename Executor>
+void submitResume(Executor& executor, std::coroutine_handle<> coroutine) {
+	if constexpr (requires { executor.submit(crampl::Function<void()>(Resume{coroutine})); })
+		executor.submit(crampl::Function<void()>(Resume{coroutine}));
+	else
+		std::invoke(executor, crampl::Function<void()>(Resume{coroutine}));
+}
+
+// Coroutine driving a Task for sync_wait. Signals its waiter under the mutex, so the waiter cannot return
+// and destroy the condition variable before notify_one is done with it.
+class SyncWaiter {
+public:
+	struct promise_type {
+		struct FinalAwaiter {
+			bool await_ready() noexcept {
+				return false;
+			}
+
+			void await_suspend(std::coroutine_handle<promise_type> coroutine) noexcept {
+				promise_type& promise = coroutine.promise();
+				std::lock_guard lock(*promise.mutex);
+				*promise.done = true;
+				promise.condition->notify_one();
+			}
+
+			void await_resume() noexcept {}
+		};
+
+		SyncWaiter get_return_object() noexcept {
+			return SyncWaiter(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_always initial_suspend() noexcept {
+			return {};
+		}
+
+		FinalAwaiter final_suspend() noexcept {
+			return {};
+		}
+
+		void return_void() noexcept {}
+
+		void unhandled_exception() noexcept {
+			std::terminate();
+		}
+
+		std::mutex* mutex = nullptr;
+		std::condition_variable* condition = nullptr;
+		bool* done = nullptr;
+	};
+
+	SyncWaiter(SyncWaiter&& other) noexcept
+		: coroutine(std::exchange(other.coroutine, {})) {}
+	~SyncWaiter() {
+		if (coroutine)
+			coroutine.destroy();
+	}
+
+	void run() {
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool done = false;
+		coroutine.promise().mutex = &mutex;
+		coroutine.promise().condition = &condition;
+		coroutine.promise().done = &done;
+		coroutine.resume();
+		std::unique_lock lock(mutex);
+		condition.wait(lock, [&] { return done; });
+	}
+
+private:
+	explicit SyncWaiter(std::coroutine_handle<promise_type> coroutine) noexcept
+		: coroutine(coroutine) {}
+
+	std::coroutine_handle<promise_type> coroutine;
+};
+
+}
+
+// Awaitable that suspends the awaiting coroutine and hands a Function<void()> resuming it to the executor,
+// either through executor.submit(function) or by calling executor(function). Any executor accepting
+// crampl::Functions, such as a WorkStealingPool, therefore runs the rest of the coroutine.
+template<typename Executor>
+class ScheduleAwaiter {
+public:
+	explicit ScheduleAwaiter(Executor& executor) noexcept
+		: executor(&executor) {}
+
+	bool await_ready() const noexcept {
+		return false;
+	}
+
+	void await_suspend(std::coroutine_handle<> coroutine) {
+		detail::submitResume(*executor, coroutine);
+	}
+
+	void await_resume() const noexcept {}
+
+private:
+	Executor* executor;
+};
+
+// co_await schedule(executor) continues the coroutine on the executor.
+template<typename Executor>
+ScheduleAwaiter<Executor> schedule(Executor& executor) noexcept {
+	return ScheduleAwaiter<Executor>(executor);
+}
+
+// Runs the task to completion, blocking the calling thread until it has finished wherever it was resumed,
+// and returns its result or rethrows its exception.
+template<typename T>
+T sync_wait(Task<T> task) {
+	if constexpr (std::is_void_v<T>) {
+		std::exception_ptr exception;
+		auto waiter = [](Task<T>& task, std::exception_ptr& exception) -> detail::SyncWaiter {
+			try {
+				co_await task;
+			} catch (...) {
+				exception = std::current_exception();
+			}
+		}(task, exception);
+		waiter.run();
+		if (exception)
+			std::rethrow_exception(exception);
+	} else {
+		using Stored = std::conditional_t<std::is_reference_v<T>, std::add_pointer_t<T>, std::optional<T>>;
+		Stored result {};
+		std::exception_ptr exception;
+		auto waiter = [](Task<T>& task, Stored& result, std::exception_ptr& exception) -> detail::SyncWaiter {
+			try {
+				if constexpr (std::is_reference_v<T>)
+					result = &co_await task;
+				else
+					result.emplace(co_await task);
+			} catch (...) {
+				exception = std::current_exception();
+			}
+		}(task, result, exception);
+		waiter.run();
+		if (exception)
+			std::rethrow_exception(exception);
+		if constexpr (std::is_reference_v<T>)
+			return *result;
+		else
+			return std::move(*result);
+	}
+}
+
+}
@@ -0,0 +1,242 @@
+/**
+ *
+ *
+ * @file WorkStealingPool.h
+ * @brief Work-stealing thread pool running crampl::Functions from per-worker Chase-Lev deques.
+ * @date 10/16/26
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Function.h"
+#include "MPMCQueue.h"
+
+namespace crampl {
+
+// Bounded Chase-Lev deque: its owner pushes and pops at the bottom, other threads steal from the top.
+// Values are stored in the slots themselves, so pushing does not allocate. A thief claims a slot with a CAS
+// on top before it moves the value out, and each slot is marked full until its value has been moved out,
+// which keeps the owner from reusing a slot a thief is still reading.
+template<typename T>
+class WorkStealingDeque {
+public:
+	// Capacity is rounded up to a power of two.
+	explicit WorkStealingDeque(std::size_t capacity)
+		: mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1), slots(std::make_unique<Slot[]>(mask + 1)) {}
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+	~WorkStealingDeque() {
+		while (pop()) {}
+	}
+
+	// Owner only. Fails if the deque is full.
+	bool push(T&& value) {
+		std::int64_t b = bottom.load(std::memory_order_relaxed);
+		std::int64_t t = top.load(std::memory_order_acquire);
+		Slot& slot = slots[static_cast<std::size_t>(b) & mask];
+		if (b - t > static_cast<std::int64_t>(mask) || slot.full.load(std::memory_order_acquire))
+			return false;
+		new (slot.storage) T(std::move(value));
+		slot.full.store(true, std::memory_order_relaxed);
+		bottom.store(b + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Owner only. Takes the most recently pushed value.
+	std::optional<T> pop() {
+		std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_seq_cst);
+		std::int64_t t = top.load(std::memory_order_seq_cst);
+		if (t > b) {
+			bottom.store(b + 1, std::memory_order_release);
+			return std::nullopt;
+		}
+		if (t == b) {
+			// Last value: race the thieves for it.
+			bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_release);
+			if (!won)
+				return std::nullopt;
+		}
+		return take(b);
+	}
+
+	// Any thread. Takes the least recently pushed value; fails if the deque is empty or another thread
+	// took the value first.
+	std::optional<T> steal() {
+		std::int64_t t = top.load(std::memory_order_seq_cst);
+		std::int64_t b = bottom.load(std::memory_order_seq_cst);
+		if (t >= b || !top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return std::nullopt;
+		return take(t);
+	}
+
+	// Number of values in the deque; only a snapshot while other threads steal.
+	std::size_t size_approx() const noexcept {
+		std::int64_t b = bottom.load(std::memory_order_relaxed);
+		std::int64_t t = top.load(std::memory_order_relaxed);
+		return b > t ? static_cast<std::size_t>(b - t) : 0;
+	}
+
+private:
+	struct Slot {
+		std::atomic<bool> full {false};
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+	std::optional<T> take(std::int64_t index) {
+		Slot& slot = slots[static_cast<std::size_t>(index) & mask];
+		T* value = std::launder(reinterpret_cast<T*>(slot.storage));
+		std::optional<T> result(std::move(*value));
+		value->~T();
+		slot.full.store(false, std::memory_order_release);
+		return result;
+	}
+
+	const std::size_t mask;
+	const std::unique_ptr<Slot[]> slots;
+	alignas(detail::cacheLineSize) std::atomic<std::int64_t> top {0};
+	alignas(detail::cacheLineSize) std::atomic<std::int64_t> bottom {0};
+};
+
+// Thread pool with one WorkStealingDeque per worker. Tasks submitted by a worker go to its own deque and
+// are run newest first, which keeps their data in cache; tasks submitted by other threads go to a shared
+// MPMCQueue. Idle workers steal the oldest task of a random other worker before they go to sleep. Neither
+// submitting nor running a task allocates or takes a lock. The destructor runs all tasks still queued.
+template<typename Task = Function<void()>>
+class WorkStealingPool {
+public:
+	explicit WorkStealingPool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()),
+	                          std::size_t queueCapacity = 4096, std::size_t dequeCapacity = 1024)
+		: injected(queueCapacity) {
+		workers.reserve(threads);
+		for (std::size_t i = 0; i < threads; ++i)
+			workers.push_back(std::make_unique<Worker>(dequeCapacity, i));
+		for (auto& worker : workers)
+			worker->thread = std::thread([this, worker = worker.get()] { run(*worker); });
+	}
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+	~WorkStealingPool() {
+		stopping.store(true, std::memory_order_seq_cst);
+		epoch.fetch_add(1, std::memory_order_seq_cst);
+		epoch.notify_all();
+		for (auto& worker : workers)
+			worker->thread.join();
+	}
+
+	// Queues a task unless the queue it goes to is full; the task is left untouched in that case.
+	bool try_submit(Task& task) {
+		Worker* worker = currentWorker();
+		bool queued = worker ? worker->deque.push(std::move(task)) : injected.try_push(std::move(task));
+		if (queued)
+			wake();
+		return queued;
+	}
+
+	// Queues a task. A worker whose deque is full runs the task right away; other threads wait for
+	// room in the shared queue.
+	void submit(Task task) {
+		while (!try_submit(task)) {
+			if (currentWorker()) {
+				task();
+				return;
+			}
+			std::this_thread::yield();
+		}
+	}
+
+	std::size_t size() const noexcept {
+		return workers.size();
+	}
+
+private:
+	struct Worker {
+		Worker(std::size_t dequeCapacity, std::size_t index): deque(dequeCapacity), random(index * 0x9e3779b97f4a7c15ull + 1) {}
+		WorkStealingDeque<Task> deque;
+		std::uint64_t random;
+		std::thread thread;
+	};
+
+	// Worker of this pool running on the calling thread, if any.
+	Worker* currentWorker() const {
+		return current.pool == this ? current.worker : nullptr;
+	}
+
+	void wake() {
+		epoch.fetch_add(1, std::memory_order_seq_cst);
+		if (sleepers.load(std::memory_order_seq_cst) > 0)
+			epoch.notify_one();
+	}
+
+	std::optional<Task> findTask(Worker& self) {
+		if (auto task = self.deque.pop())
+			return task;
+		if (auto task = injected.try_pop())
+			return task;
+		std::size_t count = workers.size();
+		self.random ^= self.random << 13;
+		self.random ^= self.random >> 7;
+		self.random ^= self.random << 17;
+		std::size_t start = static_cast<std::size_t>(self.random % count);
+		for (std::size_t i = 0; i < count; ++i) {
+			Worker& victim = *workers[(start + i) % count];
+			if (&victim == &self)
+				continue;
+			if (auto task = victim.deque.steal())
+				return task;
+		}
+		return std::nullopt;
+	}
+
+	void run(Worker& self) {
+		current = {this, &self};
+		for (;;) {
+			if (auto task = findTask(self)) {
+				(*task)();
+				continue;
+			}
+			// Register as sleeper before the last look for work, so that a concurrent submit either
+			// is seen by that look or bumps the epoch and wakes this worker.
+			sleepers.fetch_add(1, std::memory_order_seq_cst);
+			std::uint32_t seen = epoch.load(std::memory_order_seq_cst);
+			if (auto task = findTask(self)) {
+				sleepers.fetch_sub(1, std::memory_order_seq_cst);
+				(*task)();
+				continue;
+			}
+			if (stopping.load(std::memory_order_seq_cst)) {
+				sleepers.fetch_sub(1, std::memory_order_seq_cst);
+				break;
+			}
+			epoch.wait(seen, std::memory_order_seq_cst);
+			sleepers.fetch_sub(1, std::memory_order_seq_cst);
+		}
+		current = {};
+	}
+
+	struct Current {
+		const WorkStealingPool* pool = nullptr;
+		Worker* worker = nullptr;
+	};
+	static inline thread_local Current current;
+
+	MPMCQueue<Task> injected;
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::atomic<bool> stopping {false};
+	alignas(detail::cacheLineSize) std::atomic<std::uint32_t> epoch {0};
+	alignas(detail::cacheLineSize) std::atomic<std::int32_t> sleepers {0};
+};
+
+}
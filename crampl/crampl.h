@@ -9,9 +9,25 @@
 #pragma once
 
 #include "MemberComparator.h"
+#include "MemberHasher.h"
+#include "NormalizedKey.h"
+#include "MemberSort.h"
 #include "NonTypeList.h"
 #include "ForEachMember.h"
 #include "PointerRange.h"
 #include "MultiKeyMap.h"
+#include "MultiKeyMapView.h"
+#include "MultiKeyMapSnapshot.h"
+#include "MultiKeyMapStats.h"
+#include "PmrMultiKeyMap.h"
+#include "ConcurrentMultiKeyMap.h"
+#include "FlatHashMap.h"
+#include "SortedVectorMap.h"
 #include "ContainerContainer.h"
 #include "Function.h"
+#include "FunctionVector.h"
+#include "SizeClassPool.h"
+#include "MPMCQueue.h"
+#include "WorkStealingPool.h"
+#include "Task.h"
+#include "ParallelSort.h"
@@ -0,0 +1,80 @@
+/**
+ *
+ *
+ * @file ConcurrentMultiKeyMap.cpp
+ * @brief 
+ * @date 10/16/26
+ */
+#include <atomic>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "crampl/ConcurrentMultiKeyMap.h"
+#include "crampl/PmrMultiKeyMap.h"
+
+TEST_CASE("ConcurrentMultiKeyMap") {
+    crampl::ConcurrentMultiKeyMap<crampl::MultiKeyMap<std::map, std::string, int, double>, 8> m;
+    REQUIRE(crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple("a"), std::forward_as_tuple(1), std::forward_as_tuple(1.0)) == 1.0);
+    REQUIRE(crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple("a"), std::forward_as_tuple(1), std::forward_as_tuple(2.0)) == 1.0);
+    crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple("b"), std::forward_as_tuple(1), std::forward_as_tuple(3.0));
+    REQUIRE(m.size() == 2);
+    REQUIRE(crampl::find(m, "a", 1) == 1.0);
+    REQUIRE(crampl::find(m, "b", 1) == 3.0);
+    REQUIRE(!crampl::find(m, "b", 2));
+    REQUIRE(crampl::find(m, "b")->size() == 1);
+
+    const auto& cm = m;
+    double seen = 0.0;
+    REQUIRE(cm.visit([&](const double& value) { seen = value; }, "b", 1));
+    REQUIRE(seen == 3.0);
+    REQUIRE(!cm.visit([&](const double&) { seen = 0.0; }, "c", 1));
+    REQUIRE(seen == 3.0);
+
+    REQUIRE(!crampl::erase(m, "b", 2));
+    REQUIRE(crampl::erase(m, "b", 1));
+    REQUIRE(!crampl::find(m, "b"));
+    REQUIRE(m.size() == 1);
+}
+
+TEST_CASE("ConcurrentMultiKeyMap flat and pmr") {
+    crampl::ConcurrentMultiKeyMap<crampl::FlatMultiKeyMap<std::map, int, int, double>, 4> flat;
+    crampl::emplace(flat, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(2), std::forward_as_tuple(3.0));
+    REQUIRE(crampl::find(flat, 1, 2) == 3.0);
+    REQUIRE(!crampl::find(flat, 2, 1));
+
+    std::pmr::monotonic_buffer_resource resource;
+    crampl::ConcurrentMultiKeyMap<crampl::pmr::MultiKeyMap<int, int, double>, 4> pmr(&resource);
+    crampl::emplace(pmr, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(2), std::forward_as_tuple(3.0));
+    REQUIRE(crampl::find(pmr, 1, 2) == 3.0);
+}
+
+TEST_CASE("ConcurrentMultiKeyMap threads") {
+    crampl::ConcurrentMultiKeyMap<crampl::MultiKeyMap<std::map, int, int, int>> m;
+    constexpr int writers = 4;
+    constexpr int perWriter = 1000;
+    std::atomic<int> mismatches = 0;
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; ++w) {
+        threads.emplace_back([&, w] {
+            for (int i = 0; i < perWriter; ++i)
+                crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(i), std::forward_as_tuple(w), std::forward_as_tuple(i * w));
+        });
+        threads.emplace_back([&, w] {
+            for (int i = 0; i < perWriter; ++i)
+                if (auto value = crampl::find(m, i, w); value && *value != i * w)
+                    ++mismatches;
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    REQUIRE(mismatches == 0);
+    REQUIRE(m.size() == perWriter);
+    for (int w = 0; w < writers; ++w)
+        for (int i = 0; i < perWriter; ++i)
+            REQUIRE(crampl::find(m, i, w) == i * w);
+}
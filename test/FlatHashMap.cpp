@@ -0,0 +1,165 @@
+/**
+ *
+ *
+ * @file FlatHashMap.cpp
+ * @brief 
+ * @date 10/16/26
+ */
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "crampl/FlatHashMap.h"
+#include "crampl/MultiKeyMap.h"
+#include "crampl/MultiKeyMapView.h"
+
+TEST_CASE("FlatHashMap basics") {
+    crampl::FlatHashMap<std::string, int> m;
+    REQUIRE(m.empty());
+    REQUIRE(m.begin() == m.end());
+    REQUIRE(m.find("a") == m.end());
+    REQUIRE(m.erase("a") == 0);
+
+    auto [it, inserted] = m.emplace("a", 1);
+    REQUIRE(inserted);
+    REQUIRE(it->first == "a");
+    REQUIRE(it->second == 1);
+    REQUIRE(!m.emplace("a", 2).second);
+    REQUIRE(m.at("a") == 1);
+    m["b"] = 2;
+    REQUIRE(m.size() == 2);
+    REQUIRE(m.contains("b"));
+    REQUIRE_THROWS_AS(m.at("c"), std::out_of_range);
+
+    crampl::FlatHashMap<std::string, int> copy = m;
+    REQUIRE(copy == m);
+    crampl::FlatHashMap<std::string, int> moved = std::move(copy);
+    REQUIRE(moved == m);
+    REQUIRE(copy.empty());
+
+    REQUIRE(m.erase("a") == 1);
+    REQUIRE(!m.contains("a"));
+    REQUIRE(m.size() == 1);
+    REQUIRE(m != moved);
+
+    crampl::FlatHashMap<int, int> list { {1, 2}, {3, 4} };
+    REQUIRE(list.size() == 2);
+    REQUIRE(list.at(3) == 4);
+}
+
+TEST_CASE("FlatHashMap against std::unordered_map") {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> keys(0, 2000);
+    crampl::FlatHashMap<int, int> m;
+    std::unordered_map<int, int> reference;
+    for (int i = 0; i < 20000; ++i) {
+        int key = keys(rng);
+        switch (rng() % 3) {
+            case 0:
+            case 1: {
+                bool inserted = m.emplace(key, i).second;
+                REQUIRE(inserted == reference.emplace(key, i).second);
+                break;
+            }
+            case 2:
+                REQUIRE(m.erase(key) == reference.erase(key));
+                break;
+        }
+        REQUIRE(m.size() == reference.size());
+        REQUIRE(m.load_factor() <= m.max_load_factor());
+    }
+    for (const auto& [key, value] : reference)
+        REQUIRE(m.at(key) == value);
+    std::size_t visited = 0;
+    for (const auto& [key, value] : m) {
+        REQUIRE(reference.at(key) == value);
+        ++visited;
+    }
+    REQUIRE(visited == reference.size());
+
+    for (auto it = m.begin(); it != m.end();)
+        it = it->first % 2 ? m.erase(it) : std::next(it);
+    for (const auto& [key, value] : m)
+        REQUIRE(key % 2 == 0);
+    m.clear();
+    REQUIRE(m.empty());
+    REQUIRE(m.begin() == m.end());
+}
+
+namespace {
+struct StringHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+};
+}
+
+TEST_CASE("FlatHashMap transparent lookup") {
+    crampl::FlatHashMap<std::string, int, StringHash, std::equal_to<>> m;
+    m.emplace("abc", 1);
+    std::string_view key = "abc";
+    REQUIRE(m.find(key)->second == 1);
+    REQUIRE(m.contains("abc"));
+    REQUIRE(m.erase(key) == 1);
+}
+
+TEST_CASE("FlatHashMap as MapKind") {
+    crampl::MultiKeyMap<crampl::FlatHashMap, int, std::string, int, double> m;
+    crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple("a"), std::forward_as_tuple(2), std::forward_as_tuple(3.0));
+    crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple("b"), std::forward_as_tuple(2), std::forward_as_tuple(4.0));
+    REQUIRE(crampl::find(m, 1, "a", 2) == 3.0);
+    REQUIRE(*crampl::find_ptr(m, 1, "b", 2) == 4.0);
+    REQUIRE(!crampl::find(m, 2, "a", 2));
+    REQUIRE(std::ranges::distance(crampl::entries(m)) == 2);
+    REQUIRE(crampl::erase(m, 1, "a", 2));
+    REQUIRE(crampl::erase(m, 1, "b", 2));
+    REQUIRE(m.empty());
+
+    std::vector<std::tuple<int, int, int>> entries;
+    for (int i = 0; i < 100; ++i)
+        entries.emplace_back(i % 7, i, i * 2);
+    crampl::MultiKeyMap<crampl::FlatHashMap, int, int, int> bulk;
+    crampl::bulk_load(bulk, entries);
+    REQUIRE(bulk.size() == 7);
+    for (int i = 0; i < 100; ++i)
+        REQUIRE(crampl::find(bulk, i % 7, i) == i * 2);
+
+    std::vector<std::tuple<int, int>> batch;
+    for (int i = 0; i < 120; ++i)
+        batch.emplace_back((119 - i) % 7, 119 - i);
+    std::vector<const int*> results(batch.size());
+    REQUIRE(crampl::find_batch(std::as_const(bulk), batch, results) == 100);
+    for (std::size_t i = 0; i < batch.size(); ++i)
+        REQUIRE(results[i] == crampl::find_ptr(std::as_const(bulk), std::get<0>(batch[i]), std::get<1>(batch[i])));
+
+    crampl::FlatMultiKeyMap<crampl::FlatHashMap, int, int, double> flat;
+    crampl::emplace(flat, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(2), std::forward_as_tuple(3.0));
+    REQUIRE(crampl::find(flat, 1, 2) == 3.0);
+
+    std::pmr::monotonic_buffer_resource resource;
+    crampl::MultiKeyMap<crampl::pmr::FlatHashMap, int, int, double> pmr(&resource);
+    crampl::emplace(pmr, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(2), std::forward_as_tuple(3.0));
+    REQUIRE(pmr.at(1).get_allocator().resource() == &resource);
+}
+
+TEST_CASE("FlatHashMap pmr keys") {
+    // Keys built from other types allocate from the map's resource, never from the default one.
+    std::pmr::monotonic_buffer_resource resource(std::pmr::new_delete_resource());
+    struct DefaultResourceGuard {
+        std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+        ~DefaultResourceGuard() { std::pmr::set_default_resource(previous); }
+    } guard;
+    std::string_view longKey = "a key that is too long for the small string buffer";
+    crampl::pmr::FlatHashMap<std::pmr::string, int> m(&resource);
+    REQUIRE(m.emplace(longKey.data(), 1).second);
+    REQUIRE(m.try_emplace(std::string(longKey) + "!", 2).second);
+    REQUIRE(m.emplace(std::piecewise_construct, std::forward_as_tuple(40, 'x'), std::forward_as_tuple(3)).second);
+    REQUIRE(!m.emplace(longKey.data(), 4).second);
+    REQUIRE(m.size() == 3);
+    REQUIRE(m.at(std::pmr::string(longKey, &resource)) == 1);
+    REQUIRE(m.at(std::pmr::string(40, 'x', &resource)) == 3);
+}
@@ -1,6 +1,12 @@
 #include <crampl/crampl.h>
 #include <catch2/catch_all.hpp>
 #include <functional>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <memory_resource>
+#include <vector>
 
 class NonCopyableInt {
 public:
@@ -89,8 +95,8 @@ TEST_CASE("function")
 
 		REQUIRE(c.copyCount() == 0);
 		REQUIRE(c.moveCount() == 0);
-		REQUIRE(f(c) == std::make_tuple(1, 1));
-		REQUIRE(f(c) == std::make_tuple(1, 1));
+		REQUIRE(f(c) == std::make_tuple(1, 0));
+		REQUIRE(f(c) == std::make_tuple(1, 0));
 	}
 
 	{
@@ -201,3 +207,306 @@ TEST_CASE("function")
 		REQUIRE(f() == std::make_tuple(0, 0));
 	}
 }
+
+TEST_CASE("function inline buffer")
+{
+	struct ThreeWords {
+		void* a;
+		void* b;
+		void* c;
+	};
+	auto small = [w = ThreeWords{}]() { return w.a == nullptr; };
+	auto large = [w = ThreeWords{}, x = ThreeWords{}]() { return w.a == x.a; };
+
+	static_assert(!crampl::Function<bool()>::storedInline<decltype(small)>);
+	static_assert(crampl::Function<bool(), 3 * sizeof(void*)>::storedInline<decltype(small)>);
+	static_assert(!crampl::Function<bool(), 3 * sizeof(void*)>::storedInline<decltype(large)>);
+	static_assert(crampl::Function<bool() const, 3 * sizeof(void*)>::storedInline<decltype(small)>);
+	static_assert(sizeof(crampl::InplaceFunction<bool(), 3 * sizeof(void*)>) == 4 * sizeof(void*));
+
+	crampl::InplaceFunction<bool(), 3 * sizeof(void*)> f = small;
+	REQUIRE(f());
+	crampl::Function<bool(), 3 * sizeof(void*)> g = large;
+	REQUIRE(g());
+	auto h = std::move(g);
+	REQUIRE(h());
+	REQUIRE_THROWS_AS(g(), crampl::bad_call);
+
+	struct alignas(32) Aligned {
+		int value = 7;
+		int operator()() const { return value; }
+	};
+	static_assert(!crampl::Function<int()>::storedInline<Aligned>);
+	static_assert(crampl::Function<int() const, sizeof(Aligned), alignof(Aligned)>::storedInline<Aligned>);
+	crampl::InplaceFunction<int() const, sizeof(Aligned), alignof(Aligned)> aligned = Aligned{};
+	REQUIRE(aligned() == 7);
+	auto moved = std::move(aligned);
+	REQUIRE(moved() == 7);
+
+	// Mutable state lives in the buffer, so it persists across calls and moves.
+	crampl::InplaceFunction<int(), 2 * sizeof(void*)> counter = [count = 0, step = 2]() mutable { return count += step; };
+	REQUIRE(counter() == 2);
+	REQUIRE(counter() == 4);
+	auto movedCounter = std::move(counter);
+	REQUIRE(movedCounter() == 6);
+
+	// Callables that are moved between inline buffers are destroyed exactly once each.
+	auto alive = std::make_shared<int>(0);
+	{
+		crampl::Function<long(), 2 * sizeof(void*)> owner = [alive]() { return alive.use_count(); };
+		REQUIRE(owner() == 2);
+		auto next = std::move(owner);
+		REQUIRE(next() == 2);
+	}
+	REQUIRE(alive.use_count() == 1);
+}
+
+namespace {
+struct RelocatableCounter {
+	static inline int moves = 0;
+	static inline int destructions = 0;
+	std::unique_ptr<int> value = std::make_unique<int>(5);
+	RelocatableCounter() = default;
+	RelocatableCounter(RelocatableCounter&& other) noexcept: value(std::move(other.value)) { ++moves; }
+	~RelocatableCounter() { ++destructions; }
+	int operator()() const { return *value; }
+};
+}
+
+template<>
+struct crampl::is_trivially_relocatable<RelocatableCounter> : std::true_type {};
+
+TEST_CASE("function relocation")
+{
+	static_assert(sizeof(crampl::Function<void()>) == 2 * sizeof(void*));
+	static_assert(sizeof(crampl::Function<int(int) const>) == 2 * sizeof(void*));
+
+	RelocatableCounter::moves = 0;
+	RelocatableCounter::destructions = 0;
+	{
+		crampl::Function<int()> f = RelocatableCounter{};
+		int moves = RelocatableCounter::moves;
+		int destructions = RelocatableCounter::destructions;
+		auto g = std::move(f);
+		auto h = std::move(g);
+		REQUIRE(RelocatableCounter::moves == moves);
+		REQUIRE(RelocatableCounter::destructions == destructions);
+		REQUIRE(h() == 5);
+		REQUIRE_THROWS_AS(f(), crampl::bad_call);
+	}
+	// The relocated object is destroyed exactly once, by its last owner.
+	REQUIRE(RelocatableCounter::destructions == RelocatableCounter::moves + 1);
+}
+
+namespace {
+int sumWith(crampl::FunctionRef<int(int) const> f) {
+	int sum = 0;
+	for (int i = 0; i < 4; ++i)
+		sum += f(i);
+	return sum;
+}
+
+int triple(int i) {
+	return 3 * i;
+}
+}
+
+TEST_CASE("function ref")
+{
+	static_assert(sizeof(crampl::FunctionRef<void()>) == 2 * sizeof(void*));
+	static_assert(sizeof(crampl::FunctionRef<int(int) const>) == 2 * sizeof(void*));
+
+	int offset = 10;
+	REQUIRE(sumWith([offset](int i) { return i + offset; }) == 46);
+	REQUIRE(sumWith(triple) == 18);
+	REQUIRE(sumWith(&triple) == 18);
+
+	int calls = 0;
+	auto counting = [&calls](int i) mutable { ++calls; return i; };
+	crampl::FunctionRef<int(int)> ref = counting;
+	REQUIRE(ref(7) == 7);
+	REQUIRE(calls == 1);
+	crampl::FunctionRef<int(int)> copy = ref;
+	REQUIRE(copy(8) == 8);
+	REQUIRE(calls == 2);
+
+	// Mutable callables are referred to, not copied.
+	auto counter = [count = 0]() mutable { return ++count; };
+	crampl::FunctionRef<int()> counterRef = counter;
+	counterRef();
+	counterRef();
+	REQUIRE(counter() == 3);
+
+	crampl::Function<int(), 2 * sizeof(void*)> function = [count = 0, step = 5]() mutable { return count += step; };
+	crampl::FunctionRef<int()> functionRef = function;
+	REQUIRE(functionRef() == 5);
+	REQUIRE(function() == 10);
+	REQUIRE(functionRef() == 15);
+
+	const crampl::Function<int(int) const> constFunction = [](int i) { return -i; };
+	REQUIRE(sumWith(constFunction) == -6);
+
+	crampl::Function<int(int) const> empty;
+	REQUIRE_THROWS_AS(sumWith(empty), crampl::bad_call);
+
+	// Const callables can be referred to by non-const signatures, but are still only invoked as const.
+	const auto constLambda = [offset](int i) { return i - offset; };
+	crampl::FunctionRef<int(int)> constRef = constLambda;
+	REQUIRE(constRef(12) == 2);
+	REQUIRE(sumWith(constLambda) == -34);
+	const auto constMutable = [count = 0]() mutable { return ++count; };
+	static_assert(!std::is_constructible_v<crampl::FunctionRef<int()>, decltype(constMutable)&>);
+	static_assert(std::is_constructible_v<crampl::FunctionRef<int()>, decltype(counter)&>);
+
+	crampl::FunctionRef<void(std::string&)> append = [](std::string& s) { s += "!"; };
+	std::string s = "hi";
+	append(s);
+	REQUIRE(s == "hi!");
+}
+
+namespace {
+struct CountingResource : std::pmr::memory_resource {
+	int allocations = 0;
+	int deallocations = 0;
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+		++allocations;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+	void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+		++deallocations;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+};
+}
+
+TEST_CASE("function allocator")
+{
+	CountingResource resource;
+	std::array<int, 16> payload {};
+	payload[3] = 42;
+	{
+		crampl::Function<int()> f(std::allocator_arg, &resource, [payload] { return payload[3]; });
+		REQUIRE(resource.allocations == 1);
+		REQUIRE(f() == 42);
+		auto g = std::move(f);
+		REQUIRE(resource.allocations == 1);
+		REQUIRE(g() == 42);
+
+		// Inline callables do not allocate.
+		crampl::Function<int()> small(std::allocator_arg, &resource, [] { return 1; });
+		REQUIRE(small() == 1);
+		REQUIRE(resource.allocations == 1);
+
+		crampl::Function<int() const> c(std::allocator_arg, std::pmr::polymorphic_allocator<int>(&resource), [payload] { return payload[3] + 1; });
+		REQUIRE(c() == 43);
+		REQUIRE(resource.allocations == 2);
+	}
+	REQUIRE(resource.deallocations == 2);
+
+	auto alive = std::make_shared<int>();
+	{
+		crampl::Function<long()> f(std::allocator_arg, std::allocator<char>(), [alive, payload] { return alive.use_count(); });
+		REQUIRE(f() == 2);
+	}
+	REQUIRE(alive.use_count() == 1);
+}
+
+TEST_CASE("size class pool")
+{
+	CountingResource upstream;
+	{
+		crampl::pmr::SizeClassPool pool(&upstream, 4096);
+		std::vector<crampl::Function<int()>> functions;
+		for (int i = 0; i < 100; ++i) {
+			std::array<int, 8> payload {i};
+			functions.emplace_back(std::allocator_arg, &pool, [payload] { return payload[0]; });
+		}
+		for (int i = 0; i < 100; ++i)
+			REQUIRE(functions[i]() == i);
+		int chunks = upstream.allocations;
+		REQUIRE(chunks < 10);
+		functions.clear();
+		for (int i = 0; i < 100; ++i) {
+			std::array<int, 8> payload {i};
+			functions.emplace_back(std::allocator_arg, &pool, [payload] { return payload[0]; });
+		}
+		REQUIRE(upstream.allocations == chunks);
+
+		void* large = pool.allocate(4000);
+		REQUIRE(upstream.allocations == chunks + 1);
+		pool.deallocate(large, 4000);
+		REQUIRE(upstream.deallocations == 1);
+
+		std::vector<void*> blocks;
+		for (std::size_t size : {1, 16, 17, 100, 512, 1024}) {
+			void* block = pool.allocate(size);
+			REQUIRE(reinterpret_cast<std::uintptr_t>(block) % alignof(std::max_align_t) == 0);
+			std::memset(block, 0xab, size);
+			blocks.push_back(block);
+		}
+		std::size_t i = 0;
+		for (std::size_t size : {1, 16, 17, 100, 512, 1024})
+			pool.deallocate(blocks[i++], size);
+	}
+	REQUIRE(upstream.allocations == upstream.deallocations);
+
+	crampl::Function<int()> local(std::allocator_arg, &crampl::pmr::thread_pool(), [payload = std::array<int, 8>{7}] { return payload[0]; });
+	REQUIRE(local() == 7);
+}
+
+TEST_CASE("function argument forwarding")
+{
+	auto byValue = [](CopyMoveCounter v) { return std::make_tuple(v.copyCount(), v.moveCount()); };
+	auto byRef = [](const CopyMoveCounter& v) { return std::make_tuple(v.copyCount(), v.moveCount()); };
+	auto byRvalue = [](CopyMoveCounter&& v) { CopyMoveCounter sink = std::move(v); return std::make_tuple(sink.copyCount(), sink.moveCount()); };
+	CopyMoveCounter c;
+
+	crampl::Function<std::tuple<int, int>(CopyMoveCounter)> f = byValue;
+	REQUIRE(f(c) == byValue(c));
+	// Temporaries are materialized at the call, so they are moved once, like an xvalue in a direct call.
+	CopyMoveCounter d;
+	REQUIRE(f(CopyMoveCounter{}) == byValue(std::move(d)));
+	REQUIRE(f(std::move(c)) == std::make_tuple(0, 1));
+
+	auto large = [byValue, padding = std::array<char, 64>{}](CopyMoveCounter v) { return byValue(std::move(v)); };
+	crampl::Function<std::tuple<int, int>(CopyMoveCounter) const> heap = large;
+	REQUIRE(!decltype(heap)::storedInline<decltype(large)>);
+	REQUIRE(heap(c) == std::make_tuple(1, 1));
+
+	crampl::Function<std::tuple<int, int>(const CopyMoveCounter&)> g = byRef;
+	REQUIRE(g(c) == std::make_tuple(0, 0));
+
+	crampl::Function<std::tuple<int, int>(CopyMoveCounter&&)> h = byRvalue;
+	REQUIRE(h(CopyMoveCounter{}) == std::make_tuple(0, 1));
+
+	// A by-value parameter is initialized straight from the caller's argument, also when converting.
+	crampl::Function<std::size_t(std::string)> length = [](std::string s) { return s.size(); };
+	REQUIRE(length("abc") == 3);
+	std::string s = "abcd";
+	REQUIRE(length(s) == 4);
+	REQUIRE(s == "abcd");
+	REQUIRE(length(std::move(s)) == 4);
+
+	crampl::FunctionRef<std::tuple<int, int>(CopyMoveCounter) const> ref = byValue;
+	REQUIRE(ref(c) == byValue(c));
+	REQUIRE(ref(CopyMoveCounter{}) == std::make_tuple(0, 1));
+	crampl::FunctionRef<std::tuple<int, int>(CopyMoveCounter)> functionRef = f;
+	REQUIRE(functionRef(c) == byValue(c));
+
+	crampl::Function<int(int, double, int&)> mixed = [](int a, double b, int& out) { return out = a + int(b); };
+	int out = 0;
+	REQUIRE(mixed(1, 2.5, out) == 3);
+	REQUIRE(out == 3);
+
+	// Explicit constructors of parameter types are not used for conversions, like in a direct call.
+	auto vectorSize = [](std::vector<int> v) { return v.size(); };
+	static_assert(!std::is_invocable_v<decltype(vectorSize), int>);
+	static_assert(!std::is_invocable_v<crampl::Function<std::size_t(std::vector<int>)>, int>);
+	static_assert(!std::is_invocable_v<const crampl::Function<std::size_t(std::vector<int>) const>, int>);
+	static_assert(!std::is_invocable_v<crampl::FunctionRef<std::size_t(std::vector<int>)>, int>);
+	static_assert(!std::is_invocable_v<crampl::Function<std::size_t(std::vector<int>)>, std::vector<int>, int>);
+	static_assert(std::is_invocable_v<crampl::Function<std::size_t(std::vector<int>)>, std::vector<int>&>);
+}
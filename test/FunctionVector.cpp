@@ -0,0 +1,114 @@
+/**
+ *
+ *
+ * @file FunctionVector.cpp
+ * @brief 
+ * @date 10/16/26
+ */
+#include <array>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "crampl/FunctionVector.h"
+
+namespace {
+struct Event {
+    int id;
+};
+}
+
+TEST_CASE("FunctionVector") {
+    crampl::FunctionVector<void(const Event&)> listeners;
+    REQUIRE(listeners.empty());
+    listeners(Event{0});
+
+    std::vector<int> seen;
+    auto alive = std::make_shared<int>(0);
+    for (int i = 0; i < 200; ++i) {
+        if (i % 3 == 0) {
+            listeners.push_back([&seen, i](const Event& e) { seen.push_back(e.id * 1000 + i); });
+        } else if (i % 3 == 1) {
+            // Larger than a Function's inline buffer and not trivially relocatable.
+            listeners.push_back([&seen, i, alive, padding = std::array<char, 40>{}](const Event& e) {
+                seen.push_back(e.id * 1000 + i + padding[0]);
+            });
+        } else {
+            listeners.push_back([&seen, i, name = std::string(30, 'x')](Event e) { seen.push_back(e.id * 1000 + i + int(name.size()) - 30); });
+        }
+    }
+    REQUIRE(listeners.size() == 200);
+    REQUIRE(listeners.size_bytes() <= listeners.capacity_bytes());
+    REQUIRE(alive.use_count() == 1 + 67);
+
+    listeners(Event{3});
+    REQUIRE(seen.size() == 200);
+    for (int i = 0; i < 200; ++i)
+        REQUIRE(seen[i] == 3000 + i);
+
+    seen.clear();
+    int index = 0;
+    for (auto listener : listeners) {
+        if (index++ % 50 == 0)
+            listener(Event{4});
+    }
+    REQUIRE(seen == std::vector<int>{4000, 4050, 4100, 4150});
+
+    auto moved = std::move(listeners);
+    REQUIRE(listeners.empty());
+    REQUIRE(moved.size() == 200);
+    seen.clear();
+    moved(Event{1});
+    REQUIRE(seen.size() == 200);
+
+    std::size_t capacity = moved.capacity_bytes();
+    moved.clear();
+    REQUIRE(moved.empty());
+    REQUIRE(moved.capacity_bytes() == capacity);
+    REQUIRE(alive.use_count() == 1);
+
+    crampl::FunctionVector<int(int)> results;
+    results.reserve_bytes(1024);
+    results.push_back([](int x) { return x + 1; });
+    results.push_back([](int x) { return x * 2; });
+    std::vector<int> values;
+    for (auto f : results)
+        values.push_back(f(5));
+    REQUIRE(values == std::vector<int>{6, 10});
+}
+
+TEST_CASE("FunctionVector call constraints") {
+    using Listeners = crampl::FunctionVector<void(int)>;
+    static_assert(std::is_invocable_v<Listeners&, int>);
+    static_assert(std::is_invocable_v<Listeners&, short>);
+    static_assert(!std::is_invocable_v<Listeners&, std::string>);
+    static_assert(!std::is_invocable_v<Listeners&, int, int>);
+    // Arguments reach every callable as lvalues, so move-only arguments cannot be passed by value.
+    static_assert(!std::is_invocable_v<crampl::FunctionVector<void(std::unique_ptr<int>)>&, std::unique_ptr<int>>);
+
+    // Stored callables may be stateful, so a const FunctionVector can neither be called nor iterated.
+    static_assert(std::ranges::forward_range<Listeners&>);
+    static_assert(!std::ranges::range<const Listeners&>);
+    static_assert(!std::is_invocable_v<const Listeners&, int>);
+
+    crampl::FunctionVector<int(std::string&)> appenders;
+    appenders.push_back([](std::string& s) { s += "a"; return 0; });
+    appenders.push_back([count = 0](std::string& s) mutable { s += std::to_string(++count); return count; });
+    std::string text;
+    appenders(text);
+    appenders(text);
+    REQUIRE(text == "a1a2");
+
+    // Signatures with rvalue reference parameters are rejected by a static_assert; temporaries are
+    // broadcast through const lvalue references instead.
+    crampl::FunctionVector<void(const std::string&)> sizes;
+    std::size_t total = 0;
+    sizes.push_back([&total](const std::string& s) { total += s.size(); });
+    sizes.push_back([&total](std::string s) { total += s.size(); });
+    sizes(std::string("xyz"));
+    REQUIRE(total == 6);
+}
@@ -25,6 +25,10 @@
 #include <crampl/crampl.h>
 #include <catch2/catch_all.hpp>
 #include <algorithm>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <vector>
 
 TEST_CASE("Single integer struct comparison.", "[single_int]")
 {
@@ -290,3 +294,95 @@ TEST_CASE("Getter function comparison.", "[getter_function]")
 		for (rhs.a = -1; rhs.a < 2; ++rhs.a)
 			REQUIRE(cmp(lhs, rhs) == (lhs.a < rhs.a));
 }
+
+TEST_CASE("Three-way member comparison.", "[three_way]")
+{
+	struct S { int a; int b; };
+	crampl::ThreeWayMemberComparator<&S::a, &S::b> cmp;
+	static_assert(std::is_same_v<decltype(cmp.compare(S{}, S{})), std::strong_ordering>);
+	S lhs, rhs;
+	for (lhs.a = -1; lhs.a < 2; ++lhs.a)
+		for (lhs.b = -1; lhs.b < 2; ++lhs.b)
+			for (rhs.a = -1; rhs.a < 2; ++rhs.a)
+				for (rhs.b = -1; rhs.b < 2; ++rhs.b) {
+					auto reference = std::tie(lhs.a, lhs.b) <=> std::tie(rhs.a, rhs.b);
+					REQUIRE(cmp.compare(lhs, rhs) == reference);
+					REQUIRE(cmp(lhs, rhs) == (reference < 0));
+				}
+}
+
+namespace {
+int threeWayCalls = 0;
+
+template<typename T>
+struct CountingThreeWay {
+	auto operator()(const T& lhs, const T& rhs) const {
+		++threeWayCalls;
+		return lhs <=> rhs;
+	}
+};
+}
+
+TEST_CASE("Three-way member comparison compares each member once.", "[three_way_single_pass]")
+{
+	struct S { std::string a; std::string b; float c; };
+	crampl::ThreeWayMemberComparatorTemplate<CountingThreeWay, &S::a, &S::b, &S::c> cmp;
+	static_assert(std::is_same_v<decltype(cmp.compare(S{}, S{})), std::partial_ordering>);
+	S x{"x", "y", 1.0f}, y{"x", "z", 0.0f}, z{"w", "z", 0.0f};
+
+	threeWayCalls = 0;
+	REQUIRE(cmp.compare(x, y) == std::partial_ordering::less);
+	REQUIRE(threeWayCalls == 2);
+	threeWayCalls = 0;
+	REQUIRE(!cmp(x, z));
+	REQUIRE(threeWayCalls == 1);
+	threeWayCalls = 0;
+	REQUIRE(cmp.compare(x, x) == std::partial_ordering::equivalent);
+	REQUIRE(threeWayCalls == 3);
+}
+
+TEST_CASE("Three-way member comparison skips unordered members.", "[three_way_unordered]")
+{
+	struct S { float a; int b; };
+	crampl::ThreeWayMemberComparator<&S::a, &S::b> cmp;
+	crampl::MemberComparator<&S::a, &S::b> reference;
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+	S x{nan, 1}, y{nan, 2}, z{1.0f, 0};
+	REQUIRE(cmp.compare(x, y) == std::partial_ordering::less);
+	REQUIRE(cmp(x, y) == reference(x, y));
+	REQUIRE(cmp(y, x) == reference(y, x));
+	REQUIRE(cmp(x, z) == reference(x, z));
+	REQUIRE(cmp(z, x) == reference(z, x));
+	REQUIRE(cmp.compare(x, x) == std::partial_ordering::equivalent);
+}
+
+TEST_CASE("Strong member comparison.", "[strong_ordering]")
+{
+	struct S { float a; int b; };
+	crampl::StrongMemberComparator<&S::a, &S::b> cmp;
+	static_assert(std::is_same_v<decltype(cmp.compare(S{}, S{})), std::strong_ordering>);
+	REQUIRE(cmp.compare(S{-0.0f, 1}, S{0.0f, 0}) == std::strong_ordering::less);
+	REQUIRE(cmp.compare(S{1.0f, 1}, S{1.0f, 0}) == std::strong_ordering::greater);
+	REQUIRE(cmp.compare(S{1.0f, 1}, S{1.0f, 1}) == std::strong_ordering::equal);
+
+	std::vector<S> values{{2.0f, 1}, {1.0f, 3}, {2.0f, 0}, {-1.0f, 5}};
+	std::sort(values.begin(), values.end(), cmp);
+	REQUIRE(std::is_sorted(values.begin(), values.end(), crampl::MemberComparator<&S::a, &S::b>()));
+}
+
+TEST_CASE("Three-way complex member comparison.", "[three_way_complex]")
+{
+	struct S
+	{
+		int *ptr;
+		int size;
+	};
+	auto reference = [](const S &lhs, const S &rhs) -> bool {
+		return crampl::PointerRange { lhs.ptr, lhs. size } < crampl::PointerRange { rhs.ptr, rhs.size };
+	};
+	test_complex_member<S, crampl::ThreeWayMemberComparator<crampl::ConstructFromMembers<crampl::PointerRange, &S::ptr, &S::size>()>>(reference);
+	test_complex_member<S, crampl::ThreeWayMemberComparator<crampl::PointerRangeCompare<CustomCompare, &S::ptr, &S::size>()>>([](const S &lhs, const S &rhs) -> bool {
+		return crampl::PointerRange<int*, CustomCompare<int>> { lhs.ptr, lhs. size } < crampl::PointerRange<int*, CustomCompare<int>> { rhs.ptr, rhs.size };
+	});
+	test_complex_member<S, crampl::ThreeWayMemberComparator<crampl::ConstructFromMembers<PointerAndSize, &S::ptr, &S::size>()>>(reference);
+}
@@ -0,0 +1,120 @@
+/**
+ *
+ *
+ * @file MemberHasher.cpp
+ * @brief 
+ * @date 10/16/26
+ */
+#include <crampl/crampl.h>
+#include <catch2/catch_all.hpp>
+#include <array>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+TEST_CASE("Member hasher agrees with member equality.", "[member_hasher]")
+{
+	struct S { int a; int b; double c; };
+	crampl::MemberHasher<&S::a, &S::b> hash;
+	crampl::MemberEqual<&S::a, &S::b> equal;
+	S lhs{0, 0, 1.0}, rhs{0, 0, 2.0};
+	for (lhs.a = -2; lhs.a <= 2; ++lhs.a)
+		for (lhs.b = -2; lhs.b <= 2; ++lhs.b)
+			for (rhs.a = -2; rhs.a <= 2; ++rhs.a)
+				for (rhs.b = -2; rhs.b <= 2; ++rhs.b) {
+					bool reference = lhs.a == rhs.a && lhs.b == rhs.b;
+					REQUIRE(equal(lhs, rhs) == reference);
+					if (reference)
+						REQUIRE(hash(lhs) == hash(rhs));
+				}
+}
+
+TEST_CASE("Member hasher distributes keys.", "[member_hasher_distribution]")
+{
+	struct S { int a; short b; char c; };
+	crampl::MemberHasher<&S::a, &S::b> hash;
+	std::set<std::size_t> hashes;
+	std::set<std::size_t> lowBits;
+	for (int a = 0; a < 64; ++a)
+		for (short b = 0; b < 64; ++b) {
+			hashes.insert(hash(S{a, b, 0}));
+			lowBits.insert(hash(S{a, b, 0}) & 4095);
+		}
+	REQUIRE(hashes.size() == 64 * 64);
+	// Close to the expected number of distinct values of 4096 random 12-bit numbers.
+	REQUIRE(lowBits.size() > 2400);
+
+	// Swapping member values changes the hash.
+	crampl::MemberHasher<&S::a, &S::c> separate;
+	REQUIRE(separate(S{1, 0, 2}) != separate(S{2, 0, 1}));
+}
+
+TEST_CASE("Member hasher with getters, strings and constructed members.", "[member_hasher_complex]")
+{
+	struct S {
+		std::string name;
+		int *ptr;
+		int size;
+		float weight;
+		int get() const { return size * 2; }
+	};
+	std::array<int, 3> first{1, 2, 3}, second{1, 2, 3};
+	S lhs{"name", first.data(), 3, 0.0f}, rhs{"name", second.data(), 3, -0.0f};
+
+	crampl::MemberHasher<&S::name, &S::get, &S::weight> hash;
+	crampl::MemberEqual<&S::name, &S::get, &S::weight> equal;
+	REQUIRE(equal(lhs, rhs));
+	REQUIRE(hash(lhs) == hash(rhs));
+	rhs.name = "other";
+	REQUIRE(!equal(lhs, rhs));
+	REQUIRE(hash(lhs) != hash(rhs));
+
+	constexpr auto range = crampl::ConstructFromMembers<crampl::PointerRange, &S::ptr, &S::size>();
+	crampl::MemberHasher<range> rangeHash;
+	crampl::MemberEqual<range> rangeEqual;
+	REQUIRE(rangeEqual(lhs, rhs));
+	REQUIRE(rangeHash(lhs) == rangeHash(rhs));
+	second[2] = 4;
+	REQUIRE(!rangeEqual(lhs, rhs));
+	REQUIRE(rangeHash(lhs) != rangeHash(rhs));
+
+	constexpr auto tuple = crampl::ConstructFromMembers<std::tuple, &S::name, &S::size>();
+	crampl::MemberHasher<tuple> tupleHash;
+	crampl::MemberEqual<tuple> tupleEqual;
+	rhs.name = "name";
+	REQUIRE(tupleEqual(lhs, rhs));
+	REQUIRE(tupleHash(lhs) == tupleHash(rhs));
+}
+
+namespace {
+template<typename T>
+struct ParityHash {
+	std::size_t operator()(int value) const { return value & 1; }
+};
+
+template<typename T>
+struct ParityEqual {
+	bool operator()(int lhs, int rhs) const { return (lhs & 1) == (rhs & 1); }
+};
+}
+
+TEST_CASE("Member hasher in unordered containers.", "[member_hasher_unordered]")
+{
+	struct S { int a; int b; std::string c; };
+	std::unordered_set<S, crampl::MemberHasher<&S::a, &S::b>, crampl::MemberEqual<&S::a, &S::b>> set;
+	for (int a = 0; a < 10; ++a)
+		for (int b = 0; b < 10; ++b)
+			REQUIRE(set.insert(S{a, b, "first"}).second);
+	REQUIRE(!set.insert(S{3, 4, "second"}).second);
+	REQUIRE(set.size() == 100);
+	REQUIRE(set.find(S{3, 4, ""})->c == "first");
+	REQUIRE(set.find(S{3, 10, ""}) == set.end());
+
+	std::unordered_set<S, crampl::MemberHasherTemplate<ParityHash, &S::a, &S::b>, crampl::MemberEqualTemplate<ParityEqual, &S::a, &S::b>> parity;
+	for (int a = 0; a < 10; ++a)
+		for (int b = 0; b < 10; ++b)
+			parity.insert(S{a, b, ""});
+	REQUIRE(parity.size() == 4);
+}
@@ -0,0 +1,164 @@
+/**
+ *
+ *
+ * @file MemberSort.cpp
+ * @brief 
+ * @date 10/16/26
+ */
+#include <crampl/crampl.h>
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+enum class Color : signed char { red = -1, green, blue };
+
+struct Row {
+	int id;
+	std::int64_t a;
+	unsigned short b;
+	float c;
+	double d;
+	Color color;
+	bool flag;
+	std::string name;
+	const int *values;
+	int count;
+	int order;
+};
+
+std::vector<Row> randomRows(std::size_t n, const std::vector<int> &values)
+{
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<int> small(-3, 3);
+	std::vector<Row> rows(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		Row &row = rows[i];
+		row.id = int(i);
+		row.order = int(i);
+		row.a = std::int64_t(small(gen)) << (small(gen) + 40);
+		row.b = static_cast<unsigned short>(gen());
+		row.c = small(gen) == 0 ? -0.0f : float(small(gen)) / 2;
+		row.d = double(small(gen)) * 1e300;
+		row.color = Color(small(gen) % 2);
+		row.flag = small(gen) > 0;
+		std::string alphabet("\0\1ab\xff", 5);
+		std::size_t length = gen() % 4;
+		for (std::size_t j = 0; j < length; ++j)
+			row.name.push_back(alphabet[gen() % alphabet.size()]);
+		row.values = values.data() + gen() % 4;
+		row.count = int(gen() % 3);
+	}
+	return rows;
+}
+
+template<auto... M>
+void checkRadixSort(std::vector<Row> rows)
+{
+	std::vector<Row> expected = rows;
+	std::stable_sort(expected.begin(), expected.end(), crampl::MemberComparator<M...>());
+	crampl::radix_sort_by_members<M...>(rows);
+	for (std::size_t i = 0; i < rows.size(); ++i)
+		REQUIRE(rows[i].id == expected[i].id);
+}
+}
+
+TEST_CASE("Normalized keys preserve member order.", "[normalized_key]")
+{
+	struct S { int a; float b; };
+	using Key = crampl::NormalizedKey<&S::a, &S::b>;
+	static_assert(std::is_same_v<Key::type, std::uint64_t>);
+	static_assert(Key::size == 8);
+	crampl::MemberComparator<&S::a, &S::b> cmp;
+	std::vector<S> values;
+	for (int a : {-2, -1, 0, 1, 2})
+		for (float b : {-1.5f, -0.0f, 0.0f, 0.25f, 3.0f})
+			values.push_back({a, b});
+	for (const S &lhs : values)
+		for (const S &rhs : values)
+			REQUIRE(cmp(lhs, rhs) == (Key::get(lhs) < Key::get(rhs)));
+
+	static_assert(std::is_same_v<crampl::NormalizedKey<&Row::a, &Row::d>::type, std::array<unsigned char, 16>>);
+	static_assert(std::is_same_v<crampl::NormalizedKey<&Row::a, &Row::name>::type, std::string>);
+}
+
+TEST_CASE("Radix sort by members matches MemberComparator.", "[radix_sort_by_members]")
+{
+	std::vector<int> values{-1, 0, 1, -1, 0, 1};
+	for (std::size_t n : {0, 1, 50, 5000}) {
+		auto rows = randomRows(n, values);
+		checkRadixSort<&Row::b>(rows);
+		checkRadixSort<&Row::a, &Row::b>(rows);
+		checkRadixSort<&Row::c, &Row::color, &Row::flag>(rows);
+		checkRadixSort<&Row::d, &Row::a, &Row::b>(rows);
+		checkRadixSort<&Row::name>(rows);
+		checkRadixSort<&Row::name, &Row::c>(rows);
+		checkRadixSort<crampl::ConstructFromMembers<crampl::PointerRange, &Row::values, &Row::count>(), &Row::b>(rows);
+	}
+
+	std::vector<std::string> strings{"b", std::string(300, 'a') + "c", std::string(300, 'a'), "", std::string(300, 'a') + "b"};
+	struct S { std::string s; };
+	std::vector<S> objects;
+	for (int i = 0; i < 1000; ++i)
+		objects.push_back({strings[i % strings.size()]});
+	crampl::radix_sort_by_members<&S::s>(objects.begin(), objects.end());
+	REQUIRE(std::is_sorted(objects.begin(), objects.end(), crampl::MemberComparator<&S::s>()));
+}
+
+namespace {
+int getterCalls = 0;
+
+struct Computed {
+	int id;
+	std::vector<int> digits;
+	int *ptr;
+	int size;
+
+	int digitSum() const {
+		++getterCalls;
+		int sum = 0;
+		for (int digit : digits)
+			sum += digit;
+		return sum;
+	}
+};
+
+template<typename T>
+struct Greater {
+	bool operator()(const T &lhs, const T &rhs) const { return lhs > rhs; }
+};
+}
+
+TEST_CASE("Sort by members evaluates projections once.", "[sort_by_members]")
+{
+	std::mt19937 gen(7);
+	std::vector<int> data(64);
+	for (int &value : data)
+		value = int(gen() % 5);
+	std::vector<Computed> values;
+	for (int i = 0; i < 2000; ++i) {
+		Computed computed{i, {}, data.data() + gen() % 32, int(gen() % 4)};
+		for (unsigned j = gen() % 6; j > 0; --j)
+			computed.digits.push_back(int(gen() % 10));
+		values.push_back(computed);
+	}
+	constexpr auto range = crampl::ConstructFromMembers<crampl::PointerRange, &Computed::ptr, &Computed::size>();
+
+	auto check = [&](auto sort, auto comparator) {
+		std::vector<Computed> expected = values, sorted = values;
+		std::stable_sort(expected.begin(), expected.end(), comparator);
+		getterCalls = 0;
+		sort(sorted);
+		REQUIRE(getterCalls <= int(values.size()));
+		for (std::size_t i = 0; i < values.size(); ++i)
+			REQUIRE(sorted[i].id == expected[i].id);
+	};
+	check([](auto &v) { crampl::sort_by_members<&Computed::digitSum>(v); }, crampl::MemberComparator<&Computed::digitSum>());
+	check([](auto &v) { crampl::sort_by_members<&Computed::digitSum, range>(v.begin(), v.end()); },
+		crampl::MemberComparator<&Computed::digitSum, range>());
+	check([](auto &v) { crampl::sort_by_members<range, &Computed::id>(v); }, crampl::MemberComparator<range, &Computed::id>());
+	check([](auto &v) { crampl::sort_by_members<Greater, &Computed::digitSum>(v); },
+		crampl::MemberComparatorTemplate<Greater, &Computed::digitSum>());
+}
@@ -8,10 +8,12 @@
  */
 
 #include <map>
+#include <unordered_map>
 
 #include <catch2/catch_all.hpp>
 
 #include "crampl/MultiKeyMap.h"
+#include "crampl/PmrMultiKeyMap.h"
 
 using Example = crampl::MultiKeyMap<std::map, crampl::ComplexKey<int, std::greater<int>>, int, double>;
 using Example2 = crampl::MultiKeyMap<std::map, int, double, float, int, double>;
@@ -68,3 +70,264 @@ TEST_CASE("MultiKeyMap") {
     }
 
 }
+
+TEST_CASE("FlatMultiKeyMap") {
+    REQUIRE(std::is_same_v<std::map<crampl::CompositeKey<int, float, char>, double>, crampl::FlatMultiKeyMap<std::map, int, float, char, double>>);
+    REQUIRE(std::is_same_v<std::map<int, std::map<crampl::CompositeKey<int, int>, double>>, crampl::MultiKeyMap<std::map, int, crampl::CompositeKey<int, int>, double>>);
+
+    {
+        crampl::FlatMultiKeyMap<std::map, int, std::string, int, double> m;
+        auto& one = crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple("a"), std::forward_as_tuple(2), std::forward_as_tuple(1.0));
+        REQUIRE(one == 1.0);
+        auto& alsoOne = crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple("a"), std::forward_as_tuple(2), std::forward_as_tuple(2.0));
+        REQUIRE(&one == &alsoOne);
+        crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple("b"), std::forward_as_tuple(2), std::forward_as_tuple(3.0));
+        REQUIRE(m.size() == 2);
+        REQUIRE(crampl::find(m, 1, "a", 2) == std::optional<double>{1.0});
+        REQUIRE(crampl::find(m, 1, "b", 2) == std::optional<double>{3.0});
+        REQUIRE(!crampl::find(m, 1, "c", 2));
+        auto [k1, k2, k3] = m.begin()->first;
+        REQUIRE(k1 == 1);
+        REQUIRE(k2 == "a");
+        REQUIRE(k3 == 2);
+    }
+    {
+        crampl::FlatMultiKeyMap<std::unordered_map, int, std::string, double> m;
+        crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple("a"), std::forward_as_tuple(1.0));
+        crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(2), std::forward_as_tuple("a"), std::forward_as_tuple(2.0));
+        REQUIRE(m.size() == 2);
+        REQUIRE(crampl::find(m, 1, "a") == std::optional<double>{1.0});
+        REQUIRE(crampl::find(m, 2, "a") == std::optional<double>{2.0});
+        REQUIRE(!crampl::find(m, 1, "b"));
+    }
+    {
+        crampl::MultiKeyMap<std::map, int, crampl::CompositeKey<int, int>, double> m;
+        crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(2), std::forward_as_tuple(3), std::forward_as_tuple(4.0));
+        REQUIRE(crampl::find(m, 1, 2, 3) == std::optional<double>{4.0});
+        REQUIRE(!crampl::find(m, 1, 3, 2));
+        REQUIRE(!crampl::find(m, 2, 2, 3));
+        REQUIRE(crampl::find(m, 1)->size() == 1);
+    }
+}
+
+
+namespace {
+struct CountedKey {
+    static inline int constructions = 0;
+    explicit CountedKey(int v): value(v) { ++constructions; }
+    CountedKey(const CountedKey& other): value(other.value) { ++constructions; }
+    int value;
+};
+
+struct CountedLess {
+    using is_transparent = void;
+    static int get(const CountedKey& key) { return key.value; }
+    static int get(int key) { return key; }
+    template<typename L, typename R>
+    bool operator()(const L& lhs, const R& rhs) const { return get(lhs) < get(rhs); }
+};
+}
+
+TEST_CASE("MultiKeyMap find_ptr") {
+    crampl::MultiKeyMap<std::map, int, int, std::string> m { {1, { {2, "a"} }} };
+    std::string* a = crampl::find_ptr(m, 1, 2);
+    REQUIRE(a == &m[1][2]);
+    REQUIRE(crampl::find_ptr(m, 1, 3) == nullptr);
+    REQUIRE(crampl::find_ptr(m, 2, 2) == nullptr);
+    REQUIRE(crampl::find_ptr(m, 1) == &m[1]);
+
+    const auto& cm = m;
+    const std::string* ca = crampl::find_ptr(cm, 1, 2);
+    REQUIRE(ca == a);
+
+    {
+        crampl::MultiKeyMap<std::map, crampl::ComplexKey<CountedKey, CountedLess>, crampl::ComplexKey<CountedKey, CountedLess>, int> counted;
+        crampl::emplace(counted, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(2), std::forward_as_tuple(3));
+        CountedKey::constructions = 0;
+        REQUIRE(*crampl::find_ptr(counted, 1, 2) == 3);
+        REQUIRE(crampl::find_ptr(counted, 1, 3) == nullptr);
+        REQUIRE(crampl::find(counted, 1, 2) == 3);
+        REQUIRE(CountedKey::constructions == 0);
+    }
+    {
+        crampl::FlatMultiKeyMap<std::map, std::string, int, double> flat;
+        crampl::emplace(flat, std::piecewise_construct, std::forward_as_tuple("a"), std::forward_as_tuple(1), std::forward_as_tuple(1.0));
+        REQUIRE(*crampl::find_ptr(flat, "a", 1) == 1.0);
+
+        std::map<crampl::CompositeKey<std::string, int>, double, std::less<>> transparent;
+        crampl::emplace(transparent, std::piecewise_construct, std::forward_as_tuple("a"), std::forward_as_tuple(1), std::forward_as_tuple(1.0));
+        crampl::emplace(transparent, std::piecewise_construct, std::forward_as_tuple("b"), std::forward_as_tuple(1), std::forward_as_tuple(2.0));
+        REQUIRE(*crampl::find_ptr(transparent, "b", 1) == 2.0);
+        REQUIRE(crampl::find_ptr(transparent, "b", 2) == nullptr);
+    }
+}
+
+TEST_CASE("MultiKeyMap bulk_load") {
+    std::vector<std::tuple<int, std::string, int, double>> entries {
+        {2, "b", 1, 1.0}, {1, "a", 2, 2.0}, {2, "a", 1, 3.0}, {1, "a", 1, 4.0}, {2, "b", 1, 5.0}, {1, "b", 3, 6.0}
+    };
+
+    crampl::MultiKeyMap<std::map, crampl::ComplexKey<int, std::greater<int>>, std::string, int, double> expected;
+    for (const auto& [k1, k2, k3, v] : entries)
+        crampl::emplace(expected, std::piecewise_construct, std::forward_as_tuple(k1), std::forward_as_tuple(k2), std::forward_as_tuple(k3), std::forward_as_tuple(v));
+
+    {
+        auto copy = entries;
+        decltype(expected) m;
+        crampl::bulk_load(m, copy);
+        REQUIRE(m == expected);
+        REQUIRE(crampl::find(m, 2, "b", 1) == 1.0);
+    }
+    {
+        auto copy = entries;
+        crampl::MultiKeyMap<std::unordered_map, int, std::string, int, double> m;
+        crampl::bulk_load(m, copy);
+        REQUIRE(m.size() == 2);
+        REQUIRE(m[1].size() == 2);
+        REQUIRE(crampl::find(m, 2, "b", 1) == 1.0);
+        REQUIRE(crampl::find(m, 1, "b", 3) == 6.0);
+    }
+    {
+        auto copy = entries;
+        crampl::MultiKeyMap<std::map, int, crampl::CompositeKey<std::string, int>, double> m;
+        crampl::bulk_load(m, copy);
+        REQUIRE(m.size() == 2);
+        REQUIRE(m[1].size() == 3);
+        REQUIRE(crampl::find(m, 2, "b", 1) == 1.0);
+        REQUIRE(crampl::find(m, 1, "a", 1) == 4.0);
+    }
+    {
+        std::vector<std::tuple<int, int>> sorted { {1, 1}, {2, 2}, {3, 3} };
+        std::map<int, int> m { {0, 0} };
+        crampl::bulk_load_sorted(m, sorted.begin(), sorted.end());
+        REQUIRE(m == std::map<int, int>{ {0, 0}, {1, 1}, {2, 2}, {3, 3} });
+    }
+}
+
+TEST_CASE("MultiKeyMap erase") {
+    crampl::MultiKeyMap<std::map, int, int, int, double> m {
+        {1, { {1, { {1, 1.0}, {2, 2.0} }}, {2, { {1, 3.0} }} }},
+        {2, { {1, { {1, 4.0} }} }}
+    };
+    REQUIRE(!crampl::erase(m, 1, 1, 3));
+    REQUIRE(!crampl::erase(m, 3, 1, 1));
+    REQUIRE(crampl::erase(m, 1, 1, 1));
+    REQUIRE(m[1][1].size() == 1);
+    REQUIRE(crampl::erase(m, 1, 1, 2));
+    REQUIRE(m[1].count(1) == 0);
+    REQUIRE(crampl::erase(m, 2, 1, 1));
+    REQUIRE(m.count(2) == 0);
+    REQUIRE(m.size() == 1);
+
+    REQUIRE(crampl::erase(m, 1, 2));
+    REQUIRE(m.empty());
+
+    crampl::MultiKeyMap<std::unordered_map, int, crampl::CompositeKey<int, int>, double> flat;
+    crampl::emplace(flat, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(2), std::forward_as_tuple(3), std::forward_as_tuple(4.0));
+    crampl::emplace(flat, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(3), std::forward_as_tuple(3), std::forward_as_tuple(5.0));
+    REQUIRE(!crampl::erase(flat, 1, 3, 2));
+    REQUIRE(crampl::erase(flat, 1, 2, 3));
+    REQUIRE(flat.size() == 1);
+    REQUIRE(crampl::erase(flat, 1, 3, 3));
+    REQUIRE(flat.empty());
+}
+
+namespace {
+struct CountingResource : std::pmr::memory_resource {
+    std::size_t allocations = 0;
+    std::size_t live = 0;
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        ++live;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        --live;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// Fails every allocation that falls back to the default resource.
+struct NullDefaultResource {
+    NullDefaultResource(): previous(std::pmr::set_default_resource(std::pmr::null_memory_resource())) {}
+    ~NullDefaultResource() { std::pmr::set_default_resource(previous); }
+    std::pmr::memory_resource* previous;
+};
+}
+
+TEST_CASE("pmr MultiKeyMap") {
+    REQUIRE(std::is_same_v<std::pmr::map<int, std::pmr::map<int, double>>, crampl::pmr::MultiKeyMap<int, int, double>>);
+
+    CountingResource resource;
+    {
+        std::vector<std::tuple<int, int, double>> entries { {3, 1, 1.0}, {4, 1, 2.0}, {3, 2, 3.0} };
+        crampl::pmr::MultiKeyMap<int, std::pmr::string, int, double> m{&resource};
+        crampl::pmr::UnorderedMultiKeyMap<int, int, double> u{&resource};
+        {
+            NullDefaultResource nullDefault;
+            crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple("a string too long for small string optimization"), std::forward_as_tuple(2), std::forward_as_tuple(3.0));
+            crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple("b"), std::forward_as_tuple(2), std::forward_as_tuple(4.0));
+            crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(2), std::forward_as_tuple("a"), std::forward_as_tuple(2), std::forward_as_tuple(5.0));
+            crampl::bulk_load(u, entries);
+        }
+        REQUIRE(resource.allocations > 0);
+        REQUIRE(m.at(1).get_allocator().resource() == &resource);
+        REQUIRE(m.at(1).begin()->first.get_allocator().resource() == &resource);
+        REQUIRE(m.at(1).begin()->second.get_allocator().resource() == &resource);
+        REQUIRE(u.at(3).get_allocator().resource() == &resource);
+        REQUIRE(crampl::find(m, 1, "b", 2) == 4.0);
+        REQUIRE(crampl::find(u, 3, 2) == 3.0);
+    }
+    REQUIRE(resource.live == 0);
+
+    {
+        crampl::pmr::UnorderedFlatMultiKeyMap<std::pmr::string, int, double> flat{&resource};
+        NullDefaultResource nullDefault;
+        crampl::emplace(flat, std::piecewise_construct, std::forward_as_tuple("a string too long for small string optimization"), std::forward_as_tuple(1), std::forward_as_tuple(1.0));
+        REQUIRE(std::get<0>(flat.begin()->first).get_allocator().resource() == &resource);
+    }
+    REQUIRE(resource.live == 0);
+}
+
+TEST_CASE("MultiKeyMap find_batch") {
+    crampl::MultiKeyMap<std::map, int, std::string, int, double> map;
+    for (int i = 0; i < 20; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            crampl::emplace(map, std::piecewise_construct, std::forward_as_tuple(i % 4), std::forward_as_tuple(std::to_string(i)),
+                            std::forward_as_tuple(j), std::forward_as_tuple(i * 10. + j));
+        }
+    }
+
+    std::vector<std::tuple<int, std::string, int>> keys;
+    for (int i = 25; i >= 0; --i) {
+        for (int j = 6; j >= 0; j -= 2) {
+            keys.emplace_back(i % 4, std::to_string(i), j);
+            keys.emplace_back((i + 1) % 4, std::to_string(i), j);
+        }
+    }
+    std::vector<double*> results(keys.size(), reinterpret_cast<double*>(&map));
+    std::size_t found = crampl::find_batch(map, keys, results);
+
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        auto [k1, k2, k3] = keys[i];
+        REQUIRE(results[i] == crampl::find_ptr(map, k1, k2, k3));
+        expected += results[i] != nullptr;
+    }
+    REQUIRE(found == expected);
+    REQUIRE(found == 20 * 3);
+
+    std::vector<std::tuple<int, std::string>> prefixes {{1, "5"}, {2, "5"}, {1, "9"}};
+    std::vector<const std::map<int, double>*> inner(prefixes.size());
+    REQUIRE(crampl::find_batch(std::as_const(map), prefixes, inner) == 2);
+    REQUIRE(inner[0] == &map[1]["5"]);
+    REQUIRE(inner[1] == nullptr);
+    REQUIRE(inner[2] == &map[1]["9"]);
+
+    std::vector<std::tuple<int, std::string, int>> none;
+    std::vector<double*> noResults;
+    REQUIRE(crampl::find_batch(map, none, noResults) == 0);
+}
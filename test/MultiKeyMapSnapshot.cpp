@@ -0,0 +1,97 @@
+/**
+ *
+ *
+ * @file MultiKeyMapSnapshot.cpp
+ * @brief 
+ * @date 10/16/26
+ */
+#include <filesystem>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "crampl/MultiKeyMap.h"
+#include "crampl/MultiKeyMapSnapshot.h"
+
+namespace {
+struct Point {
+    double x, y;
+    char tag;
+};
+
+template<typename Map>
+auto snapshotBytes(const Map& map) {
+    std::ostringstream out;
+    crampl::write_snapshot(map, out);
+    auto str = out.str();
+    std::vector<std::uint64_t> storage((str.size() + 7) / 8);
+    std::memcpy(storage.data(), str.data(), str.size());
+    return std::make_pair(std::move(storage), str.size());
+}
+}
+
+TEST_CASE("MultiKeyMapSnapshot in memory") {
+    crampl::MultiKeyMap<std::unordered_map, int, char, std::int16_t, Point> map;
+    for (int i = 0; i < 50; ++i) {
+        for (char c = 'a'; c < 'a' + i % 5; ++c) {
+            crampl::emplace(map, std::piecewise_construct, std::forward_as_tuple(i), std::forward_as_tuple(c),
+                            std::forward_as_tuple(std::int16_t(-i)), std::forward_as_tuple(i * .5, -i * .5, c));
+        }
+    }
+    auto [storage, size] = snapshotBytes(map);
+    crampl::MultiKeyMapSnapshot<decltype(map)> snapshot {std::as_bytes(std::span(storage)).first(size)};
+
+    for (int i = 0; i < 50; ++i) {
+        for (char c = 'a'; c < 'f'; ++c) {
+            const Point* p = crampl::find_ptr(snapshot, i, c, std::int16_t(-i));
+            if (c < 'a' + i % 5) {
+                REQUIRE(p != nullptr);
+                REQUIRE(p->x == i * .5);
+                REQUIRE(p->y == -i * .5);
+                REQUIRE(p->tag == c);
+            } else {
+                REQUIRE(p == nullptr);
+            }
+        }
+        REQUIRE(!crampl::find(snapshot, i, 'a', std::int16_t(i + 1)));
+    }
+    REQUIRE(!crampl::find(snapshot, 50, 'a', std::int16_t(-50)));
+    REQUIRE(crampl::find(snapshot, 3, 'c', std::int16_t(-3))->tag == 'c');
+}
+
+TEST_CASE("MultiKeyMapSnapshot validation") {
+    crampl::MultiKeyMap<std::map, int, int, double> map;
+    crampl::emplace(map, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(2), std::forward_as_tuple(3.));
+    auto [storage, size] = snapshotBytes(map);
+    auto bytes = std::as_bytes(std::span(storage)).first(size);
+
+    crampl::MultiKeyMapSnapshot<decltype(map)> snapshot {bytes};
+    REQUIRE(*crampl::find(snapshot, 1, 2) == 3.);
+
+    using Other = crampl::MultiKeyMap<std::map, int, int, float>;
+    REQUIRE_THROWS(crampl::MultiKeyMapSnapshot<Other>{bytes});
+    REQUIRE_THROWS(crampl::MultiKeyMapSnapshot<decltype(map)>{bytes.first(8)});
+    REQUIRE_THROWS(crampl::MultiKeyMapSnapshot<decltype(map)>{bytes.subspan(8)});
+}
+
+TEST_CASE("MultiKeyMapSnapshot file") {
+    crampl::MultiKeyMap<std::map, std::uint32_t, std::uint64_t, int> map;
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        crampl::emplace(map, std::piecewise_construct, std::forward_as_tuple(i % 17), std::forward_as_tuple(i), std::forward_as_tuple(int(i) * 3));
+    }
+    auto path = std::filesystem::temp_directory_path() / "crampl_snapshot_test.bin";
+    crampl::write_snapshot(map, path);
+    {
+        crampl::MultiKeyMapSnapshot<decltype(map)> snapshot {path};
+        for (std::uint32_t i = 0; i < 1000; ++i) {
+            REQUIRE(*crampl::find(snapshot, i % 17, std::uint64_t(i)) == int(i) * 3);
+            REQUIRE(!crampl::find_ptr(snapshot, (i + 1) % 17, std::uint64_t(i)));
+        }
+    }
+    std::filesystem::remove(path);
+    REQUIRE_THROWS(crampl::MultiKeyMapSnapshot<decltype(map)>{path});
+}
@@ -0,0 +1,83 @@
+/**
+ *
+ *
+ * @file MultiKeyMapStats.cpp
+ * @brief 
+ * @date 10/16/26
+ */
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#include <catch2/catch_all.hpp>
+
+#include "crampl/FlatHashMap.h"
+#include "crampl/MultiKeyMap.h"
+#include "crampl/MultiKeyMapStats.h"
+#include "crampl/SortedVectorMap.h"
+
+TEST_CASE("MultiKeyMap stats") {
+    crampl::MultiKeyMap<std::map, int, int, double> map;
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            crampl::emplace(map, std::piecewise_construct, std::forward_as_tuple(i), std::forward_as_tuple(j), std::forward_as_tuple(1.));
+        }
+    }
+    auto stats = crampl::stats(map);
+    REQUIRE(stats.levels.size() == 2);
+    REQUIRE(stats.rootBytes == sizeof(map));
+    REQUIRE(stats.levels[0].maps == 1);
+    REQUIRE(stats.levels[0].entries == 10);
+    REQUIRE(stats.levels[1].maps == 10);
+    REQUIRE(stats.levels[1].entries == 55);
+    REQUIRE(stats.levels[1].minEntries == 1);
+    REQUIRE(stats.levels[1].maxEntries == 10);
+    REQUIRE(stats.levels[1].meanEntries() == 5.5);
+    // 1 | 2 3 | 4 5 6 7 | 8 9 10
+    REQUIRE(stats.levels[1].histogram == std::vector<std::size_t>{0, 1, 2, 4, 3});
+    REQUIRE(!stats.levels[1].loadFactor());
+    REQUIRE(stats.levels[1].heapBytes >= 55 * sizeof(std::pair<const int, double>));
+    REQUIRE(stats.bytes() > stats.levels[0].heapBytes + stats.levels[1].heapBytes);
+
+    std::ostringstream out;
+    out << stats;
+    REQUIRE(out.str().find("total bytes") != std::string::npos);
+
+    // The stream's formatting is left as it was.
+    std::ostringstream formatted;
+    formatted << std::setprecision(3);
+    formatted << stats;
+    formatted.str("");
+    formatted << 1.23456 << ' ' << 2.0;
+    REQUIRE(formatted.str() == "1.23 2");
+}
+
+TEST_CASE("MultiKeyMap stats of hashed and contiguous levels") {
+    crampl::MultiKeyMap<std::unordered_map, int, int, int> hashed;
+    crampl::MultiKeyMap<crampl::FlatHashMap, int, int, int> flat;
+    crampl::MultiKeyMap<crampl::SortedVectorMap, int, int, int> sorted;
+    auto fill = [](auto& map) {
+        for (int i = 0; i < 100; ++i)
+            crampl::emplace(map, std::piecewise_construct, std::forward_as_tuple(i % 3), std::forward_as_tuple(i), std::forward_as_tuple(i));
+    };
+    fill(hashed);
+    fill(flat);
+    fill(sorted);
+
+    auto hashedStats = crampl::stats(hashed);
+    REQUIRE(hashedStats.levels[1].entries == 100);
+    REQUIRE(hashedStats.levels[1].loadFactor());
+    REQUIRE(*hashedStats.levels[1].loadFactor() <= hashed.max_load_factor());
+
+    auto flatStats = crampl::stats(flat);
+    REQUIRE(flatStats.levels[0].heapBytes == flat.heap_bytes());
+    REQUIRE(*flatStats.levels[1].loadFactor() <= 7. / 8.);
+
+    auto sortedStats = crampl::stats(sorted);
+    REQUIRE(!sortedStats.levels[1].loadFactor());
+    std::size_t capacity = 0;
+    for (const auto& [key, inner] : sorted)
+        capacity += inner.capacity();
+    REQUIRE(sortedStats.levels[1].heapBytes == capacity * sizeof(std::pair<int, int>));
+}
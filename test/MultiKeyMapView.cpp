@@ -0,0 +1,96 @@
+/**
+ *
+ *
+ * @file MultiKeyMapView.cpp
+ * @brief 
+ * @date 10/16/26
+ */
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "crampl/MultiKeyMapView.h"
+
+TEST_CASE("MultiKeyMap entries") {
+    crampl::MultiKeyMap<std::map, int, std::string, int, double> m {
+        {1, { {"a", { {1, 1.0}, {2, 2.0} }}, {"b", {}}, {"c", { {3, 3.0} }} }},
+        {2, {}},
+        {3, { {"a", { {4, 4.0} }} }},
+        {4, { {"a", {}} }}
+    };
+    using Entry = std::tuple<int, std::string, int, double>;
+
+    static_assert(std::ranges::forward_range<decltype(crampl::entries(m))>);
+    static_assert(std::ranges::view<decltype(crampl::entries(m))>);
+
+    {
+        std::vector<Entry> all;
+        for (const auto& [k1, k2, k3, v] : crampl::entries(m))
+            all.emplace_back(k1, k2, k3, v);
+        REQUIRE(all == std::vector<Entry>{ {1, "a", 1, 1.0}, {1, "a", 2, 2.0}, {1, "c", 3, 3.0}, {3, "a", 4, 4.0} });
+    }
+    {
+        std::vector<Entry> prefixed;
+        for (const auto& [k1, k2, k3, v] : crampl::entries(m, 1))
+            prefixed.emplace_back(k1, k2, k3, v);
+        REQUIRE(prefixed == std::vector<Entry>{ {1, "a", 1, 1.0}, {1, "a", 2, 2.0}, {1, "c", 3, 3.0} });
+    }
+    {
+        std::vector<Entry> prefixed;
+        for (const auto& [k1, k2, k3, v] : crampl::entries(m, 1, "a"))
+            prefixed.emplace_back(k1, k2, k3, v);
+        REQUIRE(prefixed == std::vector<Entry>{ {1, "a", 1, 1.0}, {1, "a", 2, 2.0} });
+    }
+    REQUIRE(crampl::entries(m, 2).empty());
+    REQUIRE(crampl::entries(m, 5).empty());
+    REQUIRE(crampl::entries(m, 1, "x").empty());
+    {
+        std::vector<Entry> bounded;
+        for (const auto& [k1, k2, k3, v] : crampl::entries(m, crampl::KeyRange{2, 4}))
+            bounded.emplace_back(k1, k2, k3, v);
+        REQUIRE(bounded == std::vector<Entry>{ {3, "a", 4, 4.0} });
+    }
+    {
+        std::vector<Entry> bounded;
+        for (const auto& [k1, k2, k3, v] : crampl::entries(m, 1, crampl::KeyRange{"b", "c"}))
+            bounded.emplace_back(k1, k2, k3, v);
+        REQUIRE(bounded == std::vector<Entry>{ {1, "c", 3, 3.0} });
+    }
+    REQUIRE(crampl::entries(m, crampl::KeyRange{4, 2}).empty());
+    REQUIRE(std::ranges::distance(crampl::entries(m, crampl::KeyRange{3, 1})) == 0);
+    REQUIRE(crampl::entries(m, 1, crampl::KeyRange{"c", "a"}).empty());
+    REQUIRE(std::ranges::distance(crampl::entries(m, crampl::KeyRange{3, 3})) == 1);
+    {
+        for (auto&& [k1, k2, k3, v] : crampl::entries(m, 1))
+            v *= 10;
+        REQUIRE(crampl::find(m, 1, "a", 2) == 20.0);
+        REQUIRE(crampl::find(m, 3, "a", 4) == 4.0);
+
+        const auto& cm = m;
+        auto view = crampl::entries(cm);
+        static_assert(std::is_same_v<std::tuple_element_t<3, std::ranges::range_reference_t<decltype(view)>>, const double&>);
+        REQUIRE(std::ranges::distance(view) == 4);
+        REQUIRE(std::get<3>(*std::ranges::next(view.begin(), 2)) == 30.0);
+    }
+}
+
+TEST_CASE("MultiKeyMap entries with flat levels") {
+    crampl::MultiKeyMap<std::map, int, crampl::CompositeKey<int, int>, double> m;
+    crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(2), std::forward_as_tuple(3), std::forward_as_tuple(4.0));
+    crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(1), std::forward_as_tuple(3), std::forward_as_tuple(5.0));
+    std::vector<std::tuple<int, int, int, double>> all;
+    for (const auto& [k1, k2, k3, v] : crampl::entries(m))
+        all.emplace_back(k1, k2, k3, v);
+    REQUIRE(all == std::vector<std::tuple<int, int, int, double>>{ {1, 1, 3, 5.0}, {1, 2, 3, 4.0} });
+
+    crampl::FlatMultiKeyMap<std::unordered_map, int, int, double> flat;
+    crampl::emplace(flat, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(2), std::forward_as_tuple(3.0));
+    for (const auto& [k1, k2, v] : crampl::entries(flat)) {
+        REQUIRE(k1 == 1);
+        REQUIRE(k2 == 2);
+        REQUIRE(v == 3.0);
+    }
+}
@@ -0,0 +1,187 @@
+/**
+ *
+ *
+ * @file ParallelSort.cpp
+ * @brief 
+ * @date 10/16/26
+ */
+#include <crampl/crampl.h>
+#include <catch2/catch_all.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+struct Row {
+	int tenant;
+	long ts;
+	int id;
+	std::unique_ptr<int> payload;
+};
+
+std::vector<Row> randomRows(std::size_t n, int tenants, unsigned seed)
+{
+	std::mt19937 gen(seed);
+	std::vector<Row> rows;
+	rows.reserve(n);
+	for (std::size_t i = 0; i < n; ++i)
+		rows.push_back(Row{int(gen() % tenants), long(gen() % 1000), int(i), std::make_unique<int>(int(i))});
+	return rows;
+}
+
+struct ByTenantDescending {
+	bool operator()(const int &lhs, const int &rhs) const { return lhs > rhs; }
+	bool operator()(const long &lhs, const long &rhs) const { return lhs < rhs; }
+};
+
+template<typename Compare>
+void checkSorted(const std::vector<Row> &rows, std::vector<Row> &expected, Compare comp, bool stable)
+{
+	REQUIRE(rows.size() == expected.size());
+	if (stable) {
+		std::stable_sort(expected.begin(), expected.end(), comp);
+		for (std::size_t i = 0; i < rows.size(); ++i)
+			REQUIRE(rows[i].id == expected[i].id);
+	} else {
+		REQUIRE(std::is_sorted(rows.begin(), rows.end(), comp));
+		std::vector<bool> seen(rows.size());
+		for (const Row &row : rows) {
+			REQUIRE(*row.payload == row.id);
+			REQUIRE(!seen[row.id]);
+			seen[row.id] = true;
+		}
+	}
+}
+
+std::vector<Row> copyRows(const std::vector<Row> &rows)
+{
+	std::vector<Row> copy;
+	copy.reserve(rows.size());
+	for (const Row &row : rows)
+		copy.push_back(Row{row.tenant, row.ts, row.id, std::make_unique<int>(*row.payload)});
+	return copy;
+}
+}
+
+TEST_CASE("Parallel sort by members.", "[parallel_sort]")
+{
+	crampl::WorkStealingPool<> pool(3);
+	crampl::MemberComparator<&Row::tenant, &Row::ts> byTenantAndTime;
+	crampl::MemberComparatorOverloaded<ByTenantDescending, &Row::tenant, &Row::ts> overloaded;
+	for (std::size_t n : {std::size_t(0), std::size_t(1000), crampl::parallelSortThreshold, std::size_t(300'000)}) {
+		auto rows = randomRows(n, 50, unsigned(n));
+		auto expected = copyRows(rows);
+
+		crampl::parallel_sort(rows.begin(), rows.end(), byTenantAndTime, pool);
+		checkSorted(rows, expected, byTenantAndTime, false);
+
+		// Snapshot the unstable result first, so that the stable sort has equivalent elements to keep in order.
+		expected = copyRows(rows);
+		crampl::parallel_stable_sort(rows.begin(), rows.end(), overloaded, pool);
+		checkSorted(rows, expected, overloaded, true);
+
+		crampl::parallel_stable_sort(rows.begin(), rows.end(), crampl::MemberComparator<&Row::ts>());
+		checkSorted(rows, expected, crampl::MemberComparator<&Row::ts>(), true);
+	}
+
+	// Few distinct keys put long runs of equivalent elements into single parts.
+	auto rows = randomRows(200'000, 2, 1);
+	auto expected = copyRows(rows);
+	crampl::parallel_stable_sort(rows.begin(), rows.end(), crampl::MemberComparator<&Row::tenant>(), pool);
+	checkSorted(rows, expected, crampl::MemberComparator<&Row::tenant>(), true);
+}
+
+TEST_CASE("Parallel sort from within the pool.", "[parallel_sort_nested]")
+{
+	crampl::WorkStealingPool<> pool(1);
+	std::atomic<bool> sorted = false;
+	auto rows = randomRows(100'000, 1000, 3);
+	pool.submit([&] {
+		crampl::parallel_sort(rows.begin(), rows.end(), crampl::MemberComparator<&Row::tenant, &Row::ts>(), pool);
+		sorted = true;
+		sorted.notify_one();
+	});
+	sorted.wait(false);
+	REQUIRE(std::is_sorted(rows.begin(), rows.end(), crampl::MemberComparator<&Row::tenant, &Row::ts>()));
+}
+
+TEST_CASE("K-way merge by members.", "[kway_merge]")
+{
+	struct Entry { int key; int source; int index; };
+	crampl::MemberComparator<&Entry::key> byKey;
+	std::mt19937 gen(5);
+	crampl::WorkStealingPool<> pool(3);
+	for (std::size_t size : {std::size_t(0), std::size_t(10), std::size_t(50'000)}) {
+		std::vector<std::vector<Entry>> ranges(7);
+		std::vector<Entry> expected;
+		for (int r = 0; r < int(ranges.size()); ++r) {
+			std::size_t count = r == 3 ? 0 : size * (r + 1) / 4;
+			for (std::size_t i = 0; i < count; ++i)
+				ranges[r].push_back(Entry{int(gen() % 500), r, int(i)});
+			std::stable_sort(ranges[r].begin(), ranges[r].end(), byKey);
+			expected.insert(expected.end(), ranges[r].begin(), ranges[r].end());
+		}
+		std::stable_sort(expected.begin(), expected.end(), byKey);
+
+		std::vector<Entry> merged;
+		crampl::kway_merge(ranges, std::back_inserter(merged), byKey);
+		std::vector<Entry> parallel(expected.size());
+		REQUIRE(crampl::parallel_kway_merge(ranges, parallel.begin(), byKey, pool) == parallel.end());
+		REQUIRE(merged.size() == expected.size());
+		for (std::size_t i = 0; i < expected.size(); ++i) {
+			REQUIRE(merged[i].source == expected[i].source);
+			REQUIRE(merged[i].index == expected[i].index);
+			REQUIRE(parallel[i].source == expected[i].source);
+			REQUIRE(parallel[i].index == expected[i].index);
+		}
+	}
+}
+
+namespace {
+struct ComparisonLimitReached {};
+
+// Compares by tenant and time, and throws once limit comparisons have been made in total.
+struct ThrowingComparator {
+	std::atomic<std::size_t> *count;
+	std::size_t limit;
+	bool operator()(const Row &lhs, const Row &rhs) const
+	{
+		if (count->fetch_add(1, std::memory_order_relaxed) >= limit)
+			throw ComparisonLimitReached{};
+		return std::tie(lhs.tenant, lhs.ts) < std::tie(rhs.tenant, rhs.ts);
+	}
+};
+}
+
+TEST_CASE("Parallel sort with a throwing comparator.", "[parallel_sort_throwing]")
+{
+	crampl::WorkStealingPool<> pool(3);
+	auto sort = [&](std::vector<Row> &rows, ThrowingComparator comp, bool stable) {
+		if (stable)
+			crampl::parallel_stable_sort(rows.begin(), rows.end(), comp, pool);
+		else
+			crampl::parallel_sort(rows.begin(), rows.end(), comp, pool);
+	};
+	auto rows = randomRows(200'000, 50, 7);
+	std::atomic<std::size_t> count = 0;
+	for (bool stable : {false, true}) {
+		auto unsorted = copyRows(rows);
+		count = 0;
+		sort(unsorted, ThrowingComparator{&count, std::size_t(-1)}, stable);
+		std::size_t total = count;
+		// Throws while sorting the chunks, early and late in the merge and while merging the last elements.
+		for (std::size_t limit : {std::size_t(100), total / 2, total * 9 / 10, total - 10}) {
+			unsorted = copyRows(rows);
+			count = 0;
+			REQUIRE_THROWS_AS(sort(unsorted, ThrowingComparator{&count, limit}, stable), ComparisonLimitReached);
+			REQUIRE(unsorted.size() == rows.size());
+		}
+	}
+	// The pool is still usable afterwards.
+	crampl::parallel_sort(rows.begin(), rows.end(), crampl::MemberComparator<&Row::id>(), pool);
+	REQUIRE(std::is_sorted(rows.begin(), rows.end(), crampl::MemberComparator<&Row::id>()));
+}
@@ -0,0 +1,117 @@
+/**
+ *
+ *
+ * @file SortedVectorMap.cpp
+ * @brief 
+ * @date 10/16/26
+ */
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "crampl/SortedVectorMap.h"
+#include "crampl/MultiKeyMap.h"
+#include "crampl/MultiKeyMapView.h"
+
+TEST_CASE("SortedVectorMap basics") {
+    crampl::SortedVectorMap<std::string, int> m { {"b", 2}, {"a", 1}, {"b", 3} };
+    REQUIRE(m.size() == 2);
+    REQUIRE(m.begin()->first == "a");
+    REQUIRE(m.at("b") == 2);
+    REQUIRE(m.find("c") == m.end());
+    REQUIRE(!m.emplace("a", 5).second);
+    REQUIRE(m.emplace("c", 3).second);
+    m["0"] = 0;
+    REQUIRE(m.begin()->first == "0");
+    REQUIRE(m.lower_bound("aa")->first == "b");
+    REQUIRE(m.upper_bound("b")->first == "c");
+    REQUIRE(m.upper_bound("c") == m.end());
+    REQUIRE(m.erase("a") == 1);
+    REQUIRE(m.erase("a") == 0);
+    REQUIRE(m.size() == 3);
+    REQUIRE_THROWS_AS(m.at("a"), std::out_of_range);
+
+    std::vector<std::pair<std::string, int>> batch { {"z", 26}, {"b", 0}, {"y", 25}, {"z", 0} };
+    m.insert(batch.begin(), batch.end());
+    REQUIRE(m.size() == 5);
+    REQUIRE(m.at("b") == 2);
+    REQUIRE(m.at("z") == 26);
+    REQUIRE(std::is_sorted(m.begin(), m.end(), m.value_comp()));
+}
+
+TEST_CASE("SortedVectorMap against std::map") {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> keys(0, 500);
+    crampl::SortedVectorMap<int, int, std::greater<int>> m;
+    std::map<int, int, std::greater<int>> reference;
+    for (int i = 0; i < 5000; ++i) {
+        int key = keys(rng);
+        if (rng() % 3) {
+            REQUIRE(m.emplace(key, i).second == reference.emplace(key, i).second);
+        } else {
+            REQUIRE(m.erase(key) == reference.erase(key));
+        }
+        int probe = keys(rng);
+        REQUIRE((m.lower_bound(probe) == m.end()) == (reference.lower_bound(probe) == reference.end()));
+        if (m.lower_bound(probe) != m.end())
+            REQUIRE(m.lower_bound(probe)->first == reference.lower_bound(probe)->first);
+        if (m.upper_bound(probe) != m.end())
+            REQUIRE(m.upper_bound(probe)->first == reference.upper_bound(probe)->first);
+    }
+    REQUIRE(std::equal(m.begin(), m.end(), reference.begin(), reference.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first == rhs.first && lhs.second == rhs.second;
+    }));
+}
+
+TEST_CASE("SortedVectorMap as MapKind") {
+    using Map = crampl::MultiKeyMap<crampl::SortedVectorMap, crampl::ComplexKey<int, std::greater<int>>, std::string, double>;
+    REQUIRE(std::is_same_v<Map, crampl::SortedVectorMap<int, crampl::SortedVectorMap<std::string, double>, std::greater<int>>>);
+
+    std::vector<std::tuple<int, std::string, double>> entries { {1, "b", 1.0}, {2, "a", 2.0}, {1, "a", 3.0}, {3, "c", 4.0} };
+    Map m;
+    crampl::bulk_load(m, entries);
+    REQUIRE(m.size() == 3);
+    REQUIRE(m.begin()->first == 3);
+    REQUIRE(crampl::find(m, 1, "a") == 3.0);
+    REQUIRE(!crampl::find(m, 1, "c"));
+    crampl::emplace(m, std::piecewise_construct, std::forward_as_tuple(0), std::forward_as_tuple("x"), std::forward_as_tuple(5.0));
+    REQUIRE(crampl::find(m, 0, "x") == 5.0);
+
+    std::vector<double> bounded;
+    for (const auto& [k1, k2, v] : crampl::entries(m, crampl::KeyRange{2, 1}))
+        bounded.push_back(v);
+    REQUIRE(bounded == std::vector<double>{2.0, 3.0, 1.0});
+
+    REQUIRE(crampl::erase(m, 2, "a"));
+    REQUIRE(m.size() == 3);
+
+    std::pmr::monotonic_buffer_resource resource;
+    crampl::MultiKeyMap<crampl::pmr::SortedVectorMap, int, int, double> pmr(&resource);
+    crampl::emplace(pmr, std::piecewise_construct, std::forward_as_tuple(1), std::forward_as_tuple(2), std::forward_as_tuple(3.0));
+    REQUIRE(pmr.at(1).get_allocator().resource() == &resource);
+}
+
+TEST_CASE("SortedVectorMap pmr keys") {
+    // Keys built from other types allocate from the map's resource, never from the default one.
+    std::pmr::monotonic_buffer_resource resource(std::pmr::new_delete_resource());
+    struct DefaultResourceGuard {
+        std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+        ~DefaultResourceGuard() { std::pmr::set_default_resource(previous); }
+    } guard;
+    std::string_view longKey = "a key that is too long for the small string buffer";
+    crampl::pmr::SortedVectorMap<std::pmr::string, int> m(&resource);
+    REQUIRE(m.emplace(longKey.data(), 1).second);
+    REQUIRE(m.try_emplace(std::string(longKey) + "!", 2).second);
+    REQUIRE(m.emplace(std::piecewise_construct, std::forward_as_tuple(40, 'x'), std::forward_as_tuple(3)).second);
+    m.emplace_hint(m.end(), std::string(50, 'y'), 4);
+    m.emplace_hint(m.end(), std::piecewise_construct, std::forward_as_tuple(50, 'z'), std::forward_as_tuple(5));
+    REQUIRE(!m.emplace(longKey.data(), 6).second);
+    REQUIRE(m.size() == 5);
+    REQUIRE(m.at(std::pmr::string(longKey, &resource)) == 1);
+    REQUIRE(m.at(std::pmr::string(40, 'x', &resource)) == 3);
+    REQUIRE(m.at(std::pmr::string(50, 'z', &resource)) == 5);
+}
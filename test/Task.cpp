@@ -0,0 +1,137 @@
+/**
+ *
+ *
+ * @file Task.cpp
+ * @brief 
+ * @date 10/16/26
+ */
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "crampl/Task.h"
+#include "crampl/WorkStealingPool.h"
+
+namespace {
+crampl::Task<int> constant(int value) {
+    co_return value;
+}
+
+crampl::Task<long> sum(int count) {
+    long total = 0;
+    for (int i = 0; i < count; ++i)
+        total += co_await constant(i);
+    co_return total;
+}
+
+crampl::Task<int> depth(int n) {
+    if (n == 0)
+        co_return 0;
+    co_return 1 + co_await depth(n - 1);
+}
+
+crampl::Task<> fail() {
+    throw std::runtime_error("failed");
+    co_return;
+}
+
+crampl::Task<std::string> rethrow() {
+    try {
+        co_await fail();
+    } catch (const std::runtime_error& e) {
+        co_return e.what();
+    }
+    co_return "";
+}
+
+struct Inline {
+    int scheduled = 0;
+
+    void operator()(crampl::Function<void()> resume) {
+        ++scheduled;
+        resume();
+    }
+};
+
+template<typename Executor>
+crampl::Task<std::thread::id> hop(Executor& executor) {
+    co_await crampl::schedule(executor);
+    co_return std::this_thread::get_id();
+}
+}
+
+TEST_CASE("Task") {
+    SECTION("values and exceptions") {
+        REQUIRE(crampl::sync_wait(constant(42)) == 42);
+        REQUIRE(crampl::sync_wait(rethrow()) == "failed");
+        REQUIRE_THROWS_AS(crampl::sync_wait(fail()), std::runtime_error);
+
+        int value = 1;
+        auto reference = [](int& value) -> crampl::Task<int&> { co_return value; };
+        crampl::sync_wait(reference(value)) = 2;
+        REQUIRE(value == 2);
+
+        crampl::Task<int> task = constant(3);
+        REQUIRE(task.valid());
+        REQUIRE(!task.done());
+        crampl::Task<int> moved = std::move(task);
+        REQUIRE(!task.valid());
+        REQUIRE(crampl::sync_wait(std::move(moved)) == 3);
+    }
+
+    SECTION("symmetric transfer") {
+        // Each awaited task completes synchronously; without symmetric transfer every completion would
+        // resume its awaiter on top of the stack. GCC before 15 only reliably turns the transfer into a
+        // tail call at -O2, so the build compiles this file with -O2 and defines CRAMPL_TEST_TAIL_CALLS for
+        // those compilers; elsewhere the test uses a chain that fits the stack either way.
+#if defined(__clang__) || __GNUC__ >= 15 || defined(CRAMPL_TEST_TAIL_CALLS)
+        constexpr int count = 1'000'000;
+#else
+        constexpr int count = 1'000;
+#endif
+        REQUIRE(crampl::sync_wait(sum(count)) == long(count) * (count - 1) / 2);
+        REQUIRE(crampl::sync_wait(depth(1'000)) == 1'000);
+    }
+
+    SECTION("frame recycling") {
+        crampl::TaskFramePool::release();
+        REQUIRE(crampl::TaskFramePool::cached_frames() == 0);
+        REQUIRE(crampl::sync_wait(sum(10)) == 45);
+        std::size_t cached = crampl::TaskFramePool::cached_frames();
+        REQUIRE(cached > 0);
+        REQUIRE(crampl::sync_wait(sum(1000)) == 499'500);
+        REQUIRE(crampl::TaskFramePool::cached_frames() == cached);
+    }
+
+    SECTION("scheduling") {
+        Inline executor;
+        REQUIRE(crampl::sync_wait(hop(executor)) == std::this_thread::get_id());
+        REQUIRE(executor.scheduled == 1);
+
+        crampl::WorkStealingPool<> pool(2);
+        REQUIRE(crampl::sync_wait(hop(pool)) != std::this_thread::get_id());
+
+        std::atomic<int> completed = 0;
+        auto work = [](crampl::WorkStealingPool<>& pool, std::atomic<int>& completed, int i) -> crampl::Task<int> {
+            co_await crampl::schedule(pool);
+            int value = co_await constant(i);
+            ++completed;
+            co_return value;
+        };
+        auto all = [&](int count) -> crampl::Task<long> {
+            std::vector<crampl::Task<int>> tasks;
+            for (int i = 0; i < count; ++i)
+                tasks.push_back(work(pool, completed, i));
+            long total = 0;
+            for (auto& task : tasks)
+                total += co_await task;
+            co_return total;
+        };
+        REQUIRE(crampl::sync_wait(all(1000)) == 499'500);
+        REQUIRE(completed == 1000);
+    }
+}
@@ -0,0 +1,156 @@
+/**
+ *
+ *
+ * @file WorkStealingPool.cpp
+ * @brief 
+ * @date 10/16/26
+ */
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "crampl/MPMCQueue.h"
+#include "crampl/WorkStealingPool.h"
+
+TEST_CASE("MPMCQueue") {
+    crampl::MPMCQueue<std::unique_ptr<int>> queue(3);
+    REQUIRE(queue.capacity() == 4);
+    REQUIRE(!queue.try_pop());
+    for (int i = 0; i < 4; ++i)
+        REQUIRE(queue.try_emplace(std::make_unique<int>(i)));
+    auto extra = std::make_unique<int>(4);
+    REQUIRE(!queue.try_push(std::move(extra)));
+    REQUIRE(extra);
+    REQUIRE(queue.size_approx() == 4);
+    for (int i = 0; i < 4; ++i)
+        REQUIRE(**queue.try_pop() == i);
+    REQUIRE(!queue.try_pop());
+    REQUIRE(queue.try_push(std::move(extra)));
+
+    constexpr int producers = 4;
+    constexpr int perProducer = 20000;
+    crampl::MPMCQueue<crampl::Function<int()>> tasks(64);
+    std::atomic<long> sum = 0;
+    std::atomic<int> consumed = 0;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < perProducer; ++i) {
+                crampl::Function<int()> task = [value = p * perProducer + i] { return value; };
+                while (!tasks.try_push(std::move(task)))
+                    std::this_thread::yield();
+            }
+        });
+        threads.emplace_back([&] {
+            while (consumed.load() < producers * perProducer) {
+                if (auto task = tasks.try_pop()) {
+                    sum += (*task)();
+                    ++consumed;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    long n = producers * perProducer;
+    REQUIRE(sum == n * (n - 1) / 2);
+}
+
+TEST_CASE("WorkStealingDeque") {
+    crampl::WorkStealingDeque<std::unique_ptr<int>> deque(4);
+    for (int i = 0; i < 4; ++i)
+        REQUIRE(deque.push(std::make_unique<int>(i)));
+    auto extra = std::make_unique<int>(4);
+    REQUIRE(!deque.push(std::move(extra)));
+    REQUIRE(extra);
+    REQUIRE(**deque.steal() == 0);
+    REQUIRE(**deque.pop() == 3);
+    REQUIRE(**deque.steal() == 1);
+    REQUIRE(**deque.pop() == 2);
+    REQUIRE(!deque.pop());
+    REQUIRE(!deque.steal());
+
+    // The owner pushes and pops while thieves steal; every value is taken exactly once.
+    constexpr int count = 100000;
+    crampl::WorkStealingDeque<int> shared(256);
+    std::vector<std::atomic<int>> taken(count);
+    std::atomic<bool> done = false;
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < 3; ++i) {
+        thieves.emplace_back([&] {
+            while (!done.load()) {
+                if (auto value = shared.steal())
+                    ++taken[*value];
+            }
+        });
+    }
+    for (int i = 0; i < count; ++i) {
+        while (!shared.push(int(i))) {
+            if (auto value = shared.pop())
+                ++taken[*value];
+        }
+        if (i % 3 == 0) {
+            if (auto value = shared.pop())
+                ++taken[*value];
+        }
+    }
+    while (auto value = shared.pop())
+        ++taken[*value];
+    while (shared.size_approx() > 0)
+        std::this_thread::yield();
+    done = true;
+    for (auto& thief : thieves)
+        thief.join();
+    int mismatches = 0;
+    for (auto& t : taken)
+        mismatches += t.load() != 1;
+    REQUIRE(mismatches == 0);
+}
+
+namespace {
+void countDown(crampl::WorkStealingPool<>& pool, std::atomic<int>& counter, int depth) {
+    counter.fetch_add(1);
+    if (depth == 0)
+        return;
+    for (int i = 0; i < 2; ++i)
+        pool.submit([&pool, &counter, depth] { countDown(pool, counter, depth - 1); });
+}
+}
+
+TEST_CASE("WorkStealingPool") {
+    std::atomic<int> counter = 0;
+    {
+        crampl::WorkStealingPool<> pool(4, 64, 16);
+        REQUIRE(pool.size() == 4);
+        for (int i = 0; i < 1000; ++i)
+            pool.submit([&counter] { counter.fetch_add(1); });
+    }
+    REQUIRE(counter == 1000);
+
+    // Tasks spawned by tasks go to the worker's own deque, or run inline once it is full.
+    counter = 0;
+    {
+        crampl::WorkStealingPool<> pool(4, 64, 16);
+        pool.submit([&pool, &counter] { countDown(pool, counter, 12); });
+    }
+    REQUIRE(counter == (1 << 13) - 1);
+
+    // Move-only captures.
+    std::atomic<int> sum = 0;
+    {
+        crampl::WorkStealingPool<crampl::Function<void(), 2 * sizeof(void*)>> pool(2);
+        for (int i = 0; i < 100; ++i) {
+            auto value = std::make_unique<int>(i);
+            pool.submit([value = std::move(value), &sum] { sum += *value; });
+        }
+    }
+    REQUIRE(sum == 4950);
+
+    crampl::WorkStealingPool<> idle(2);
+}